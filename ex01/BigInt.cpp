@@ -0,0 +1,568 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   BigInt.cpp                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "BigInt.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+const size_t BigInt::INLINE_LIMBS;
+const size_t BigInt::KARATSUBA_THRESHOLD;
+
+namespace {
+
+	/**
+	 * @brief Adds src into dst in place and propagates the carry through dst.
+	 *
+	 * Limbs of src beyond dn are ignored; the caller guarantees they are zero.
+	 *
+	 * @return The carry out of the most significant limb of dst.
+	 */
+	uint32_t add_into(uint32_t *dst, size_t dn, const uint32_t *src, size_t sn) {
+		uint64_t carry = 0;
+		size_t n = std::min(dn, sn);
+		size_t i = 0;
+		for (; i < n; i++) {
+			carry += static_cast<uint64_t>(dst[i]) + src[i];
+			dst[i] = static_cast<uint32_t>(carry);
+			carry >>= 32;
+		}
+		for (; carry && i < dn; i++) {
+			carry += dst[i];
+			dst[i] = static_cast<uint32_t>(carry);
+			carry >>= 32;
+		}
+		return static_cast<uint32_t>(carry);
+	}
+
+	/**
+	 * @brief Subtracts src from dst in place (dst >= src) and propagates the borrow.
+	 */
+	void subtract_from(uint32_t *dst, size_t dn, const uint32_t *src, size_t sn) {
+		uint32_t borrow = 0;
+		size_t i = 0;
+		for (; i < sn; i++) {
+			uint64_t diff = static_cast<uint64_t>(dst[i]) - src[i] - borrow;
+			dst[i] = static_cast<uint32_t>(diff);
+			borrow = static_cast<uint32_t>(diff >> 63);
+		}
+		for (; borrow && i < dn; i++) {
+			borrow = dst[i] == 0;
+			dst[i]--;
+		}
+	}
+
+	/**
+	 * @brief Schoolbook multiplication r = a * b, r holds exactly an + bn limbs.
+	 */
+	void multiply_schoolbook(const uint32_t *a, size_t an, const uint32_t *b, size_t bn, uint32_t *r) {
+		std::fill(r, r + an + bn, 0u);
+		for (size_t i = 0; i < an; i++) {
+			uint64_t carry = 0;
+			uint64_t ai = a[i];
+			for (size_t j = 0; j < bn; j++) {
+				carry += ai * b[j] + r[i + j];
+				r[i + j] = static_cast<uint32_t>(carry);
+				carry >>= 32;
+			}
+			r[i + bn] = static_cast<uint32_t>(carry);
+		}
+	}
+
+	/**
+	 * @brief Number of workspace limbs multiply_limbs needs for the given operand sizes.
+	 *
+	 * Mirrors the recursion of multiply_limbs exactly so that the workspace can be
+	 * sized once, up front.
+	 */
+	size_t multiply_workspace(size_t an, size_t bn) {
+		if (an < bn) std::swap(an, bn);
+		if (bn < BigInt::KARATSUBA_THRESHOLD) return 0;
+		if (2 * bn <= an) {
+			return 2 * bn + std::max(multiply_workspace(bn, bn), multiply_workspace(bn, an % bn));
+		}
+		size_t m = an / 2;
+		size_t la = an - m + 1;
+		size_t lb = std::max(m, bn - m) + 1;
+		size_t halves = std::max(multiply_workspace(m, m), multiply_workspace(an - m, bn - m));
+		return std::max(halves, 2 * (la + lb) + multiply_workspace(la, lb));
+	}
+
+	/**
+	 * @brief Multiplies r = a * b, r holds exactly an + bn limbs and must not alias a or b.
+	 *
+	 * Balanced operands of at least KARATSUBA_THRESHOLD limbs are split in halves and
+	 * combined with three recursive products; unbalanced operands are multiplied
+	 * chunk by chunk so every recursive call stays balanced.
+	 *
+	 * @param ws Scratch space of at least multiply_workspace(an, bn) limbs.
+	 */
+	void multiply_limbs(const uint32_t *a, size_t an, const uint32_t *b, size_t bn, uint32_t *r, uint32_t *ws) {
+		if (an < bn) {
+			std::swap(a, b);
+			std::swap(an, bn);
+		}
+		if (bn < BigInt::KARATSUBA_THRESHOLD) {
+			multiply_schoolbook(a, an, b, bn, r);
+			return;
+		}
+
+		// Unbalanced: multiply bn-sized chunks of a by b and accumulate.
+		if (2 * bn <= an) {
+			uint32_t *chunk = ws;
+			std::fill(r, r + an + bn, 0u);
+			for (size_t off = 0; off < an; off += bn) {
+				size_t len = std::min(bn, an - off);
+				multiply_limbs(a + off, len, b, bn, chunk, ws + 2 * bn);
+				add_into(r + off, an + bn - off, chunk, len + bn);
+			}
+			return;
+		}
+
+		// Karatsuba: a = a1 * B^m + a0, b = b1 * B^m + b0.
+		size_t m = an / 2;
+		size_t rn = an + bn;
+
+		// z0 = a0 * b0 and z2 = a1 * b1 land directly in the low and high halves of r.
+		multiply_limbs(a, m, b, m, r, ws);
+		multiply_limbs(a + m, an - m, b + m, bn - m, r + 2 * m, ws);
+
+		// z1 = (a0 + a1) * (b0 + b1) - z0 - z2
+		size_t la = an - m + 1;
+		size_t lb = std::max(m, bn - m) + 1;
+		uint32_t *sa = ws;
+		uint32_t *sb = sa + la;
+		uint32_t *z1 = sb + lb;
+
+		std::copy(a + m, a + an, sa);
+		sa[la - 1] = 0;
+		add_into(sa, la, a, m);
+
+		std::fill(sb, sb + lb, 0u);
+		std::copy(b + m, b + bn, sb);
+		add_into(sb, lb, b, m);
+
+		multiply_limbs(sa, la, sb, lb, z1, z1 + la + lb);
+		subtract_from(z1, la + lb, r, 2 * m);
+		subtract_from(z1, la + lb, r + 2 * m, rn - 2 * m);
+
+		add_into(r + m, rn - m, z1, la + lb);
+	}
+
+	/**
+	 * @brief Divides u (un limbs) by a single limb in place and returns the remainder.
+	 */
+	uint32_t divide_single(uint32_t *u, size_t un, uint32_t v) {
+		uint64_t rem = 0;
+		for (size_t i = un; i-- > 0;) {
+			uint64_t cur = (rem << 32) | u[i];
+			u[i] = static_cast<uint32_t>(cur / v);
+			rem = cur % v;
+		}
+		return static_cast<uint32_t>(rem);
+	}
+
+	/**
+	 * @brief Counts the leading zero bits of a non-zero limb.
+	 */
+	int leading_zeros(uint32_t x) {
+		int n = 0;
+		while (!(x & 0x80000000u)) {
+			x <<= 1;
+			n++;
+		}
+		return n;
+	}
+
+	/**
+	 * @brief Knuth's Algorithm D: q = u / v for m >= n >= 2 limbs, v[n - 1] != 0.
+	 *
+	 * @param q Quotient, m - n + 1 limbs.
+	 * @param ws Scratch space of at least m + n + 1 limbs.
+	 */
+	void divide_knuth(const uint32_t *u, size_t m, const uint32_t *v, size_t n, uint32_t *q, uint32_t *ws) {
+		const uint64_t base = 1ULL << 32;
+		uint32_t *un = ws;
+		uint32_t *vn = ws + m + 1;
+		int s = leading_zeros(v[n - 1]);
+
+		// Normalize so that the top limb of the divisor has its high bit set.
+		for (size_t i = n - 1; i > 0; i--) {
+			vn[i] = (v[i] << s) | static_cast<uint32_t>(static_cast<uint64_t>(v[i - 1]) >> (32 - s));
+		}
+		vn[0] = v[0] << s;
+		un[m] = static_cast<uint32_t>(static_cast<uint64_t>(u[m - 1]) >> (32 - s));
+		for (size_t i = m - 1; i > 0; i--) {
+			un[i] = (u[i] << s) | static_cast<uint32_t>(static_cast<uint64_t>(u[i - 1]) >> (32 - s));
+		}
+		un[0] = u[0] << s;
+
+		for (size_t j = m - n + 1; j-- > 0;) {
+			// Estimate the quotient limb from the top two limbs, then correct it.
+			uint64_t num = (static_cast<uint64_t>(un[j + n]) << 32) | un[j + n - 1];
+			uint64_t qhat = num / vn[n - 1];
+			uint64_t rhat = num % vn[n - 1];
+			while (qhat >= base || qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2])) {
+				qhat--;
+				rhat += vn[n - 1];
+				if (rhat >= base) break;
+			}
+
+			// Multiply and subtract.
+			int64_t borrow = 0;
+			int64_t t;
+			for (size_t i = 0; i < n; i++) {
+				uint64_t p = qhat * vn[i];
+				t = static_cast<int64_t>(un[i + j]) - borrow - static_cast<int64_t>(p & 0xFFFFFFFFu);
+				un[i + j] = static_cast<uint32_t>(t);
+				borrow = static_cast<int64_t>(p >> 32) - (t >> 32);
+			}
+			t = static_cast<int64_t>(un[j + n]) - borrow;
+			un[j + n] = static_cast<uint32_t>(t);
+
+			// The estimate was one too large: add the divisor back.
+			q[j] = static_cast<uint32_t>(qhat);
+			if (t < 0) {
+				q[j]--;
+				uint64_t carry = 0;
+				for (size_t i = 0; i < n; i++) {
+					carry += static_cast<uint64_t>(un[i + j]) + vn[i];
+					un[i + j] = static_cast<uint32_t>(carry);
+					carry >>= 32;
+				}
+				un[j + n] += static_cast<uint32_t>(carry);
+			}
+		}
+	}
+}
+
+/**
+ * @brief Default constructor, the value is zero.
+ */
+BigInt::BigInt() : _limbs(_inline), _size(0), _capacity(INLINE_LIMBS), _negative(false) {
+}
+
+/**
+ * @brief Constructs a BigInt from a native integer.
+ * @param value The initial value.
+ */
+BigInt::BigInt(long value) : _limbs(_inline), _size(0), _capacity(INLINE_LIMBS), _negative(false) {
+	assign(value);
+}
+
+/**
+ * @brief Destructor, releases the heap buffer if one was allocated.
+ */
+BigInt::~BigInt() {
+	if (!_isInline()) {
+		delete[] _limbs;
+	}
+}
+
+/**
+ * @brief Copy constructor.
+ * @param other The BigInt to copy from.
+ */
+BigInt::BigInt(const BigInt &other) : _limbs(_inline), _size(0), _capacity(INLINE_LIMBS), _negative(false) {
+	*this = other;
+}
+
+/**
+ * @brief Copy assignment operator, reuses the existing buffer when it is large enough.
+ * @param other The BigInt to assign from.
+ * @return Reference to the current object.
+ */
+BigInt &BigInt::operator=(const BigInt &other) {
+	if (this != &other) {
+		_reserve(other._size);
+		std::copy(other._limbs, other._limbs + other._size, _limbs);
+		_size = other._size;
+		_negative = other._negative;
+	}
+	return *this;
+}
+
+/**
+ * @brief Replaces the value with a native integer without releasing the buffer.
+ * @param value The new value.
+ */
+void BigInt::assign(long value) {
+	unsigned long magnitude = value < 0 ? 0UL - static_cast<unsigned long>(value) : static_cast<unsigned long>(value);
+
+	_negative = value < 0;
+	_size = 0;
+	while (magnitude) {
+		_limbs[_size++] = static_cast<uint32_t>(magnitude);
+		magnitude = (magnitude >> 16) >> 16;
+	}
+}
+
+/**
+ * @brief Adds rhs to the current value in place.
+ * @param rhs The value to add.
+ * @return Reference to the current object.
+ */
+BigInt &BigInt::operator+=(const BigInt &rhs) {
+	if (_negative == rhs._negative) {
+		_addMagnitude(rhs);
+	} else {
+		_subtractMagnitude(rhs);
+	}
+	return *this;
+}
+
+/**
+ * @brief Subtracts rhs from the current value in place.
+ * @param rhs The value to subtract.
+ * @return Reference to the current object.
+ */
+BigInt &BigInt::operator-=(const BigInt &rhs) {
+	if (_negative != rhs._negative) {
+		_addMagnitude(rhs);
+	} else {
+		_subtractMagnitude(rhs);
+	}
+	return *this;
+}
+
+/**
+ * @brief Computes result = lhs * rhs.
+ *
+ * @param lhs Left operand.
+ * @param rhs Right operand.
+ * @param result Destination, its buffer is reused when large enough.
+ * @param workspace Scratch limbs, grown on demand and reusable across calls.
+ */
+void BigInt::multiply(const BigInt &lhs, const BigInt &rhs, BigInt &result, std::vector<uint32_t> &workspace) {
+	if (lhs.isZero() || rhs.isZero()) {
+		result._size = 0;
+		result._negative = false;
+		return;
+	}
+
+	result._reserve(lhs._size + rhs._size);
+
+	// Fast path: single-limb operands multiply natively.
+	if (lhs._size == 1 && rhs._size == 1) {
+		uint64_t product = static_cast<uint64_t>(lhs._limbs[0]) * rhs._limbs[0];
+		result._limbs[0] = static_cast<uint32_t>(product);
+		result._limbs[1] = static_cast<uint32_t>(product >> 32);
+	} else {
+		size_t needed = multiply_workspace(lhs._size, rhs._size);
+		if (workspace.size() < needed) {
+			workspace.resize(needed);
+		}
+		multiply_limbs(lhs._limbs, lhs._size, rhs._limbs, rhs._size, result._limbs,
+			workspace.empty() ? NULL : &workspace[0]);
+	}
+
+	result._size = lhs._size + rhs._size;
+	result._negative = lhs._negative != rhs._negative;
+	result._trim();
+}
+
+/**
+ * @brief Computes quotient = lhs / rhs, truncated toward zero like native ints.
+ *
+ * @param lhs Dividend.
+ * @param rhs Divisor.
+ * @param quotient Destination, its buffer is reused when large enough.
+ * @param workspace Scratch limbs, grown on demand and reusable across calls.
+ * @throws std::domain_error if rhs is zero.
+ */
+void BigInt::divide(const BigInt &lhs, const BigInt &rhs, BigInt &quotient, std::vector<uint32_t> &workspace) {
+	if (rhs.isZero()) {
+		throw std::domain_error("BigInt: division by zero");
+	}
+	if (_compareMagnitude(lhs, rhs) < 0) {
+		quotient._size = 0;
+		quotient._negative = false;
+		return;
+	}
+
+	quotient._reserve(lhs._size - rhs._size + 1);
+	if (rhs._size == 1) {
+		std::copy(lhs._limbs, lhs._limbs + lhs._size, quotient._limbs);
+		divide_single(quotient._limbs, lhs._size, rhs._limbs[0]);
+	} else {
+		size_t needed = lhs._size + rhs._size + 1;
+		if (workspace.size() < needed) {
+			workspace.resize(needed);
+		}
+		divide_knuth(lhs._limbs, lhs._size, rhs._limbs, rhs._size, quotient._limbs, &workspace[0]);
+	}
+
+	quotient._size = lhs._size - rhs._size + 1;
+	quotient._negative = lhs._negative != rhs._negative;
+	quotient._trim();
+}
+
+/**
+ * @brief Exchanges the values (and buffers, when possible) of two BigInts.
+ * @param other The BigInt to swap with.
+ */
+void BigInt::swap(BigInt &other) {
+	if (this == &other) {
+		return;
+	}
+
+	bool thisInline = _isInline();
+	bool otherInline = other._isInline();
+	uint32_t *thisLimbs = _limbs;
+	uint32_t *otherLimbs = other._limbs;
+
+	for (size_t i = 0; i < INLINE_LIMBS; i++) {
+		std::swap(_inline[i], other._inline[i]);
+	}
+	_limbs = otherInline ? _inline : otherLimbs;
+	other._limbs = thisInline ? other._inline : thisLimbs;
+	std::swap(_size, other._size);
+	std::swap(_capacity, other._capacity);
+	std::swap(_negative, other._negative);
+}
+
+/**
+ * @brief Checks whether the value is zero.
+ * @return True if the value is zero.
+ */
+bool BigInt::isZero() const {
+	return _size == 0;
+}
+
+/**
+ * @brief Formats the value as a decimal string.
+ *
+ * Peels off nine decimal digits at a time with single-limb division.
+ *
+ * @return The decimal representation, with a leading '-' for negative values.
+ */
+std::string BigInt::toString() const {
+	if (isZero()) {
+		return "0";
+	}
+
+	std::vector<uint32_t> magnitude(_limbs, _limbs + _size);
+	std::vector<uint32_t> chunks;
+	size_t n = magnitude.size();
+
+	while (n > 0) {
+		chunks.push_back(divide_single(&magnitude[0], n, 1000000000u));
+		while (n > 0 && magnitude[n - 1] == 0) {
+			n--;
+		}
+	}
+
+	std::string result = _negative ? "-" : "";
+	char buffer[16];
+	for (size_t i = chunks.size(); i-- > 0;) {
+		uint32_t chunk = chunks[i];
+		int len = 0;
+		do {
+			buffer[len++] = static_cast<char>('0' + chunk % 10);
+			chunk /= 10;
+		} while (chunk);
+		// Every chunk except the most significant one is zero-padded to nine digits.
+		while (i + 1 != chunks.size() && len < 9) {
+			buffer[len++] = '0';
+		}
+		while (len > 0) {
+			result += buffer[--len];
+		}
+	}
+	return result;
+}
+
+bool BigInt::_isInline() const {
+	return _limbs == _inline;
+}
+
+/**
+ * @brief Grows the buffer to hold at least limbs limbs, keeping the current value.
+ */
+void BigInt::_reserve(size_t limbs) {
+	if (limbs <= _capacity) {
+		return;
+	}
+
+	size_t capacity = std::max(limbs, _capacity * 2);
+	uint32_t *buffer = new uint32_t[capacity];
+	std::copy(_limbs, _limbs + _size, buffer);
+	if (!_isInline()) {
+		delete[] _limbs;
+	}
+	_limbs = buffer;
+	_capacity = capacity;
+}
+
+/**
+ * @brief Drops leading zero limbs and normalizes the sign of zero.
+ */
+void BigInt::_trim() {
+	while (_size > 0 && _limbs[_size - 1] == 0) {
+		_size--;
+	}
+	if (_size == 0) {
+		_negative = false;
+	}
+}
+
+/**
+ * @brief |this| += |rhs|, the sign is left untouched.
+ */
+void BigInt::_addMagnitude(const BigInt &rhs) {
+	size_t rhsSize = rhs._size;
+	size_t n = std::max(_size, rhsSize);
+
+	_reserve(n + 1);
+	std::fill(_limbs + _size, _limbs + n + 1, 0u);
+	_size = n + 1;
+	add_into(_limbs, _size, rhs._limbs, rhsSize);
+	_trim();
+}
+
+/**
+ * @brief |this| = ||this| - |rhs||, flipping the sign when |rhs| is larger.
+ */
+void BigInt::_subtractMagnitude(const BigInt &rhs) {
+	if (_compareMagnitude(*this, rhs) >= 0) {
+		subtract_from(_limbs, _size, rhs._limbs, rhs._size);
+	} else {
+		// Compute rhs - this in place; each limb of this is read before it is overwritten.
+		_reserve(rhs._size);
+		std::fill(_limbs + _size, _limbs + rhs._size, 0u);
+		uint32_t borrow = 0;
+		for (size_t i = 0; i < rhs._size; i++) {
+			uint64_t diff = static_cast<uint64_t>(rhs._limbs[i]) - _limbs[i] - borrow;
+			_limbs[i] = static_cast<uint32_t>(diff);
+			borrow = static_cast<uint32_t>(diff >> 63);
+		}
+		_size = rhs._size;
+		_negative = !_negative;
+	}
+	_trim();
+}
+
+/**
+ * @brief Compares |lhs| and |rhs|.
+ * @return Negative, zero or positive like strcmp.
+ */
+int BigInt::_compareMagnitude(const BigInt &lhs, const BigInt &rhs) {
+	if (lhs._size != rhs._size) {
+		return lhs._size < rhs._size ? -1 : 1;
+	}
+	for (size_t i = lhs._size; i-- > 0;) {
+		if (lhs._limbs[i] != rhs._limbs[i]) {
+			return lhs._limbs[i] < rhs._limbs[i] ? -1 : 1;
+		}
+	}
+	return 0;
+}
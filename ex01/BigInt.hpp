@@ -0,0 +1,160 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   BigInt.hpp                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef BIGINT_HPP
+#define BIGINT_HPP
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/**
+ * @class BigInt
+ * @brief Signed arbitrary-precision integer stored as contiguous base-2^32 limbs.
+ *
+ * Values that fit in INLINE_LIMBS limbs live inside the object itself, so the common
+ * case never touches the heap. Once a value outgrows the inline storage its limbs move
+ * to a heap buffer that is kept (and reused) for the lifetime of the object, even if the
+ * value later shrinks again.
+ *
+ * Multiplication and division write into a caller-provided result and workspace so that
+ * repeated evaluation can recycle the same buffers instead of allocating per operation.
+ */
+class BigInt {
+	public:
+		/**
+		 * @brief Number of limbs stored inline before spilling to the heap.
+		 */
+		static const size_t INLINE_LIMBS = 2;
+
+		/**
+		 * @brief Operand size (in limbs) above which multiplication switches to Karatsuba.
+		 */
+		static const size_t KARATSUBA_THRESHOLD = 32;
+
+		/**
+		 * @brief Default constructor, the value is zero.
+		 */
+		BigInt();
+
+		/**
+		 * @brief Constructs a BigInt from a native integer.
+		 * @param value The initial value.
+		 */
+		BigInt(long value);
+
+		/**
+		 * @brief Destructor, releases the heap buffer if one was allocated.
+		 */
+		~BigInt();
+
+		/**
+		 * @brief Copy constructor.
+		 * @param other The BigInt to copy from.
+		 */
+		BigInt(const BigInt &other);
+
+		/**
+		 * @brief Copy assignment operator, reuses the existing buffer when it is large enough.
+		 * @param other The BigInt to assign from.
+		 * @return Reference to the current object.
+		 */
+		BigInt &operator=(const BigInt &other);
+
+		/**
+		 * @brief Replaces the value with a native integer without releasing the buffer.
+		 * @param value The new value.
+		 */
+		void assign(long value);
+
+		/**
+		 * @brief Adds rhs to the current value in place.
+		 * @param rhs The value to add.
+		 * @return Reference to the current object.
+		 */
+		BigInt &operator+=(const BigInt &rhs);
+
+		/**
+		 * @brief Subtracts rhs from the current value in place.
+		 * @param rhs The value to subtract.
+		 * @return Reference to the current object.
+		 */
+		BigInt &operator-=(const BigInt &rhs);
+
+		/**
+		 * @brief Computes result = lhs * rhs.
+		 *
+		 * Uses schoolbook multiplication for small operands and Karatsuba above
+		 * KARATSUBA_THRESHOLD limbs. result must not alias lhs or rhs.
+		 *
+		 * @param lhs Left operand.
+		 * @param rhs Right operand.
+		 * @param result Destination, its buffer is reused when large enough.
+		 * @param workspace Scratch limbs, grown on demand and reusable across calls.
+		 */
+		static void multiply(const BigInt &lhs, const BigInt &rhs, BigInt &result,
+			std::vector<uint32_t> &workspace);
+
+		/**
+		 * @brief Computes quotient = lhs / rhs, truncated toward zero like native ints.
+		 *
+		 * Uses a single-limb fast path or Knuth's Algorithm D. quotient must not alias
+		 * lhs or rhs.
+		 *
+		 * @param lhs Dividend.
+		 * @param rhs Divisor.
+		 * @param quotient Destination, its buffer is reused when large enough.
+		 * @param workspace Scratch limbs, grown on demand and reusable across calls.
+		 * @throws std::domain_error if rhs is zero.
+		 */
+		static void divide(const BigInt &lhs, const BigInt &rhs, BigInt &quotient,
+			std::vector<uint32_t> &workspace);
+
+		/**
+		 * @brief Exchanges the values (and buffers, when possible) of two BigInts.
+		 * @param other The BigInt to swap with.
+		 */
+		void swap(BigInt &other);
+
+		/**
+		 * @brief Checks whether the value is zero.
+		 * @return True if the value is zero.
+		 */
+		bool isZero() const;
+
+		/**
+		 * @brief Formats the value as a decimal string.
+		 * @return The decimal representation, with a leading '-' for negative values.
+		 */
+		std::string toString() const;
+
+	private:
+		uint32_t *_limbs;
+		size_t _size;
+		size_t _capacity;
+		bool _negative;
+		uint32_t _inline[INLINE_LIMBS];
+
+		bool _isInline() const;
+
+		void _reserve(size_t limbs);
+
+		void _trim();
+
+		void _addMagnitude(const BigInt &rhs);
+
+		void _subtractMagnitude(const BigInt &rhs);
+
+		static int _compareMagnitude(const BigInt &lhs, const BigInt &rhs);
+};
+
+#endif
@@ -19,14 +19,14 @@
  * @brief Default constructor for the RPN class.
  */
 RPN::RPN() {
-	// No specific initialization needed for this example.
+	// The big-integer stack and workspace start empty and grow on demand.
 }
 
 /**
  * @brief Destructor for the RPN class.
  */
 RPN::~RPN() {
-	// No dynamic memory to clean up in this example.
+	// Buffers are owned by std::vector and BigInt members.
 }
 
 /**
@@ -36,7 +36,7 @@ RPN::~RPN() {
  * @param other The RPN object to copy from.
  */
 RPN::RPN(const RPN &other) {
-	// No deep copying needed for this example, as we don't use dynamically allocated memory.
+	// Only scratch buffers are stored, so there is nothing meaningful to copy.
 	*this = other;
 }
 
@@ -49,7 +49,7 @@ RPN::RPN(const RPN &other) {
  */
 RPN &RPN::operator=(const RPN &other) {
 	if (this != &other) {
-		// Nothing specific to copy in this case
+		// Scratch buffers are not part of the observable state; keep our own.
 	}
 	return *this;
 }
@@ -117,3 +117,74 @@ int RPN::evaluate(const std::string &expression) {
 
 	return stack.top();
 }
+
+/**
+ * @brief Evaluate a Reverse Polish Notation expression with arbitrary precision.
+ *
+ * Operands live in _stack, whose slots are never popped from the vector: only the
+ * logical depth changes, so a slot that once held a large value keeps its limb buffer
+ * for the next value pushed there. Products and quotients are computed into _scratch
+ * and swapped into place, which exchanges buffers instead of copying limbs.
+ *
+ * @param expression The RPN expression as a string.
+ * @return std::string The decimal representation of the result.
+ * @throws std::invalid_argument if the expression is invalid.
+ */
+std::string RPN::evaluateBig(const std::string &expression) {
+	// Check for an empty expression
+	if (expression.empty()) {
+		throw std::invalid_argument("Error: Empty expression.");
+	}
+
+	std::stringstream ss(expression);
+	std::string token;
+	size_t depth = 0;
+
+	// Process each token in the expression
+	while (ss >> token) {
+		if (token.size() > 1) {
+			throw std::invalid_argument(
+				"Error: Invalid token size. Numbers must be 0-9 and operators must be single characters.");
+		} else if (isdigit(static_cast<unsigned char> (token[0]))) {
+			// If the token is a number, push it onto the stack, reusing the slot if possible
+			if (depth == _stack.size()) {
+				_stack.push_back(BigInt());
+			}
+			_stack[depth++].assign(token[0] - '0');
+		} else if (token == "+" || token == "-" || token == "*" || token == "/") {
+			// Ensure there are at least two operands on the stack
+			if (depth < 2) {
+				throw std::invalid_argument("Error: Not enough operands for the operator.");
+			}
+
+			// The result replaces the lower operand
+			BigInt &a = _stack[depth - 2];
+			const BigInt &b = _stack[depth - 1];
+
+			// Perform the operation
+			if (token == "+") a += b;
+			else if (token == "-") a -= b;
+			else if (token == "*") {
+				BigInt::multiply(a, b, _scratch, _workspace);
+				a.swap(_scratch);
+			} else if (token == "/") {
+				if (b.isZero()) {
+					throw std::invalid_argument("Error: Division by zero.");
+				}
+				BigInt::divide(a, b, _scratch, _workspace);
+				a.swap(_scratch);
+			}
+
+			depth--;
+		} else {
+			throw std::invalid_argument("Error: Invalid token in expression.");
+		}
+	}
+
+	// Ensure there's exactly one result left on the stack
+	if (depth != 1) {
+		throw std::invalid_argument("Error: Too many operands or not enough operators in the expression.");
+	}
+
+	return _stack[0].toString();
+}
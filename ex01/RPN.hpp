@@ -14,6 +14,8 @@
 #define RPN_HPP
 
 #include <string>
+#include <vector>
+#include "BigInt.hpp"
 
 /**
  * @class RPN
@@ -52,6 +54,24 @@ class RPN {
 		 * @throws std::invalid_argument if the expression is invalid.
 		 */
 		int evaluate(const std::string& expression);
+
+		/**
+		 * @brief Evaluate a Reverse Polish Notation expression with arbitrary precision.
+		 *
+		 * Accepts the same tokens as evaluate(), but intermediate values never wrap.
+		 * The operand stack and the arithmetic workspace are kept between calls so their
+		 * limb buffers are reused instead of being reallocated for every operation.
+		 *
+		 * @param expression The RPN expression as a string.
+		 * @return std::string The decimal representation of the result.
+		 * @throws std::invalid_argument if the expression is invalid.
+		 */
+		std::string evaluateBig(const std::string& expression);
+
+	private:
+		std::vector<BigInt> _stack;
+		std::vector<uint32_t> _workspace;
+		BigInt _scratch;
 };
 
 #endif
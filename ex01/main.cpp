@@ -16,6 +16,8 @@
 /**
  * @brief Main function to process input and evaluate the RPN expression.
  *
+ * With --bigint the expression is evaluated with arbitrary precision instead of int.
+ *
  * @param argc Number of command-line arguments.
  * @param argv Array of command-line argument strings.
  * @return int Exit status of the program.
@@ -23,8 +25,9 @@
 int main(int argc, char *argv[]) {
 
 	// Check for the correct number of command-line arguments
-	if (argc != 2) {
-		std::cerr << "Usage: ./RPN \"<expression>\"" << std::endl;
+	bool bigint = argc == 3 && std::string(argv[1]) == "--bigint";
+	if (argc != 2 && !bigint) {
+		std::cerr << "Usage: ./RPN [--bigint] \"<expression>\"" << std::endl;
 		return 1;
 	}
 
@@ -33,13 +36,14 @@ int main(int argc, char *argv[]) {
 		RPN rpn;
 
 		// Get the expression from the command-line arguments
-		std::string expression = argv[1];
-
-		// Evaluate the expression
-		int result = rpn.evaluate(expression);
-
-		// Output the result
-		std::cout << result << std::endl;
+		std::string expression = argv[argc - 1];
+
+		// Evaluate the expression and output the result
+		if (bigint) {
+			std::cout << rpn.evaluateBig(expression) << std::endl;
+		} else {
+			std::cout << rpn.evaluate(expression) << std::endl;
+		}
 
 	} catch (const std::invalid_argument &e) {
 		// Output the error message
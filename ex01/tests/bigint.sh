@@ -0,0 +1,78 @@
+#!/bin/sh
+# Checks ./RPN --bigint on exact powers of two and on identities that hold only if
+# Karatsuba multiplication and long division agree, at sizes well past
+# BigInt::KARATSUBA_THRESHOLD limbs.
+# Usage: tests/bigint.sh [path/to/RPN]
+
+BIN=${1:-./RPN}
+status=0
+
+# power DIGIT K: expression for DIGIT^(2^K), by repeated squaring
+power() {
+	if [ "$2" -eq 0 ]; then
+		echo "$1"
+	else
+		e=$(power "$1" $(($2 - 1)))
+		echo "$e $e *"
+	fi
+}
+
+# check NAME EXPRESSION EXPECTED
+check() {
+	actual=$("$BIN" --bigint "$2" 2>&1)
+	if [ "$actual" = "$3" ]; then
+		echo "ok: $1"
+	else
+		echo "FAIL: $1: got $actual, expected $3"
+		status=1
+	fi
+}
+
+# check_remainder NAME A B: A - (A / B) * B must lie in [0, B) for A, B > 0
+check_remainder() {
+	r=$("$BIN" --bigint "$2 $2 $3 / $3 * -")
+	b=$("$BIN" --bigint "$3")
+	if echo "$r $b" | awk '{
+		if ($1 ~ /^-/) exit 1
+		if (length($1) != length($2)) exit !(length($1) < length($2))
+		exit !($1 < $2 "")
+	}'; then
+		echo "ok: $1"
+	else
+		echo "FAIL: $1: remainder $r is not below $b"
+		status=1
+	fi
+}
+
+P64=$(power 2 6)
+P128=$(power 2 7)
+# 2^768 - 1: 24 limbs of all ones
+ONES="$(power 2 8) $(power 2 8) * $(power 2 8) * 1 -"
+# About 3200 and 1400 bits: around 100 and 45 limbs
+X="$(power 9 10) 7 * 5 +"
+Y="$(power 7 9) 3 +"
+
+check "2^64 carries into a second limb" "$P64" 18446744073709551616
+check "2^128" "$P128" 340282366920938463463374607431768211456
+check "2^128 - 1 borrows across limbs" "$P128 1 -" 340282366920938463463374607431768211455
+check "2^64 * 2^64" "$P64 $P64 * $P128 -" 0
+check "Karatsuba square divides back" "$X $X * $X / $X -" 0
+check "Karatsuba product divides back" "$X $Y * $Y / $X -" 0
+check "unbalanced product divides back" "$X $Y * $X / $Y -" 0
+check "products distribute" "$X $Y 1 + * $X $Y * - $X -" 0
+check "all-ones product divides back" "$X $ONES * $ONES / $X -" 0
+check "(2^128 - 1) / (2^64 - 1)" "$P128 1 - $P64 1 - /" 18446744073709551617
+check "2^128 / 2^64" "$P128 $P64 /" 18446744073709551616
+check "smaller / larger" "$P64 $P128 /" 0
+check "x / x" "$X $X /" 1
+check "x / 1" "$X 1 / $X -" 0
+check "negative / positive truncates" "0 7 - 2 /" -3
+check "positive / negative truncates" "7 0 2 - /" -3
+check "negative / negative" "0 7 - 0 2 - /" 3
+check "large negative / positive" "0 $X - $Y / $X $Y / +" 0
+check "division by zero" "$X 0 /" "Error: Division by zero."
+check_remainder "x mod y" "$X" "$Y"
+check_remainder "x mod all-ones" "$X" "$ONES"
+check_remainder "x mod (2^128 + 1)" "$X" "$P128 1 +"
+
+exit $status
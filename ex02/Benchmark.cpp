@@ -0,0 +1,195 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Benchmark.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Benchmark.hpp"
+#include "SimdKernels.hpp"
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+/**
+ * @brief Wall-clock microseconds elapsed since start, on CLOCK_MONOTONIC.
+ */
+double elapsed_us(const timespec &start) {
+	timespec end;
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	return (end.tv_sec - start.tv_sec) * 1e6 + (end.tv_nsec - start.tv_nsec) / 1e3;
+}
+
+/**
+ * @brief Printable name of a distribution.
+ */
+const char *distribution_name(Distribution distribution) {
+	switch (distribution) {
+		case DIST_INPUT:
+			return "input";
+		case DIST_RANDOM:
+			return "random";
+		case DIST_SORTED:
+			return "sorted";
+		case DIST_REVERSED:
+			return "reversed";
+		case DIST_FEW_UNIQUE:
+			return "few-unique";
+		default:
+			return "organ-pipe";
+	}
+}
+
+/**
+ * @brief Builds a distribution with as many values as input.
+ *
+ * Random values come from a 64-bit linear congruential generator; few-unique keeps
+ * eight distinct values; organ-pipe rises to the middle and falls back.
+ */
+std::vector<uint32_t> make_distribution(Distribution distribution, const std::vector<uint32_t> &input) {
+	size_t n = input.size();
+	std::vector<uint32_t> values(n);
+	uint64_t state = 0x9e3779b97f4a7c15ULL;
+
+	for (size_t i = 0; i < n; i++) {
+		state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+		uint32_t random = static_cast<uint32_t>(state >> 32);
+		switch (distribution) {
+			case DIST_INPUT:
+				values[i] = input[i];
+				break;
+			case DIST_RANDOM:
+				values[i] = random;
+				break;
+			case DIST_SORTED:
+				values[i] = static_cast<uint32_t>(i);
+				break;
+			case DIST_REVERSED:
+				values[i] = static_cast<uint32_t>(n - i);
+				break;
+			case DIST_FEW_UNIQUE:
+				values[i] = random % 8;
+				break;
+			default:
+				values[i] = static_cast<uint32_t>(std::min(i, n - 1 - i));
+				break;
+		}
+	}
+	return values;
+}
+
+/**
+ * @brief Nearest-rank percentile of samples, for p in (0, 100].
+ */
+double percentile(std::vector<double> samples, double p) {
+	if (samples.empty()) {
+		return 0;
+	}
+	size_t rank = static_cast<size_t>(std::ceil(p / 100 * samples.size()));
+	size_t index = rank > 0 ? rank - 1 : 0;
+
+	std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+	return samples[index];
+}
+
+namespace {
+
+	const BenchmarkEngine engines[] = {
+		{ "merge-insertion", ENGINE_MERGE_INSERTION, false, CHAIN_DEFAULT },
+		{ "merge-insertion/vector", ENGINE_MERGE_INSERTION, false, CHAIN_VECTOR },
+		{ "merge-insertion/deque", ENGINE_MERGE_INSERTION, false, CHAIN_DEQUE },
+		{ "merge-insertion/tiered", ENGINE_MERGE_INSERTION, false, CHAIN_TIERED },
+		{ "merge-insertion/arena", ENGINE_MERGE_INSERTION, true, CHAIN_DEFAULT },
+		{ "radix", ENGINE_RADIX, false, CHAIN_DEFAULT },
+		{ "introsort", ENGINE_INTROSORT, false, CHAIN_DEFAULT },
+		{ "auto", ENGINE_AUTO, false, CHAIN_DEFAULT }
+	};
+
+	/**
+	 * @brief Row name of an engine setup; the auto row also names the engine it picked.
+	 */
+	std::string row_name(const BenchmarkEngine &engine, const BenchmarkResult &result) {
+		if (engine.engine != ENGINE_AUTO) {
+			return engine.name;
+		}
+		return std::string(engine.name) + "/" + sort_engine_name(result.engine);
+	}
+
+	void print_row(const char *distribution, const char *engine, const char *container, const BenchmarkResult &result) {
+		std::cout << std::left << std::setw(12) << distribution << std::setw(23) << engine << std::setw(13) << container
+			<< std::right << std::fixed << std::setprecision(1)
+			<< std::setw(14) << result.median_us << std::setw(14) << result.p95_us << std::setw(14);
+		if (result.counted) {
+			std::cout << result.comparisons;
+		} else {
+			std::cout << "-";
+		}
+		std::cout << "  " << (result.correct ? "yes" : "NO") << std::endl;
+		std::cout.unsetf(std::ios::fixed);
+		std::cout << std::setprecision(6);
+	}
+}
+
+/**
+ * @brief Times every engine on every distribution with std::vector and std::deque.
+ *
+ * The SIMD rows, named after their level, run with the kernels capped at that level; the
+ * level chosen with --simd is restored after each of them.
+ *
+ * @param input The parsed input; its size is the size of every distribution.
+ * @param config Repetitions and arena engine options.
+ * @return Whether every kernel check passed and every sorted result matched std::sort.
+ */
+bool run_benchmark(const std::vector<uint32_t> &input, const BenchmarkConfig &config) {
+	bool all_correct = true;
+	SimdLevel selected = simd_level();
+
+	std::cout << "Benchmark: " << input.size() << " elements, " << config.warmup << " warm-up and "
+		<< config.runs << " timed runs per row, times in us" << std::endl;
+	std::cout << "SIMD kernels: " << simd_level_name(selected) << " of " << simd_level_name(simd_supported_level());
+	for (int level = SIMD_SSE41; level <= simd_supported_level(); level++) {
+		bool match = simd_matches_scalar(static_cast<SimdLevel>(level));
+		std::cout << ", " << simd_level_name(static_cast<SimdLevel>(level)) << " matches scalar: " << (match ? "yes" : "NO");
+		all_correct = all_correct && match;
+	}
+	std::cout << std::endl;
+	std::cout << std::left << std::setw(12) << "input" << std::setw(23) << "engine" << std::setw(13) << "container"
+		<< std::right << std::setw(14) << "median" << std::setw(14) << "p95" << std::setw(14) << "comparisons"
+		<< "  correct" << std::endl;
+
+	for (size_t d = 0; d < DISTRIBUTION_COUNT; d++) {
+		Distribution distribution = static_cast<Distribution>(d);
+		std::vector<uint32_t> data = make_distribution(distribution, input);
+		std::vector<uint32_t> expected(data);
+		std::sort(expected.begin(), expected.end());
+
+		for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); e++) {
+			BenchmarkResult vector_result = benchmark_engine<std::vector<uint32_t> >(engines[e], data, expected, config);
+			BenchmarkResult deque_result = benchmark_engine<std::deque<uint32_t> >(engines[e], data, expected, config);
+			print_row(distribution_name(distribution), row_name(engines[e], vector_result).c_str(), "std::vector",
+				vector_result);
+			print_row(distribution_name(distribution), row_name(engines[e], deque_result).c_str(), "std::deque",
+				deque_result);
+			all_correct = all_correct && vector_result.correct && deque_result.correct;
+		}
+
+		for (int level = SIMD_SCALAR; level <= simd_supported_level(); level++) {
+			std::string name = std::string(engines[0].name) + "/" + simd_level_name(static_cast<SimdLevel>(level));
+			set_simd_level(static_cast<SimdLevel>(level));
+			BenchmarkResult result = benchmark_engine<std::vector<uint32_t> >(engines[0], data, expected, config);
+			set_simd_level(selected);
+			print_row(distribution_name(distribution), name.c_str(), "std::vector", result);
+			all_correct = all_correct && result.correct;
+		}
+	}
+	return all_correct;
+}
@@ -0,0 +1,238 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Benchmark.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <time.h>
+#include "FordJohnson.hpp"
+#include "MergeInsertion.hpp"
+#include "SortEngine.hpp"
+
+/**
+ * @brief Inputs the benchmark sorts, all of the size of the user's input.
+ */
+enum Distribution {
+	DIST_INPUT,
+	DIST_RANDOM,
+	DIST_SORTED,
+	DIST_REVERSED,
+	DIST_FEW_UNIQUE,
+	DIST_ORGAN_PIPE
+};
+
+/**
+ * @brief Number of distributions, for iterating over them.
+ */
+const size_t DISTRIBUTION_COUNT = 6;
+
+/**
+ * @brief Main chain of a classic merge-insertion row: the one ford_johnson_chain picks for
+ * the container, or a forced one, to compare chains on the same input.
+ */
+enum BenchmarkChain {
+	CHAIN_DEFAULT,
+	CHAIN_VECTOR,
+	CHAIN_DEQUE,
+	CHAIN_TIERED
+};
+
+/**
+ * @brief One engine setup of the benchmark table.
+ */
+struct BenchmarkEngine {
+	const char *name;
+	SortEngine engine;
+	bool arena;
+	BenchmarkChain chain;
+};
+
+/**
+ * @brief Repetitions and engine tuning of a benchmark run.
+ */
+struct BenchmarkConfig {
+	size_t warmup;
+	size_t runs;
+	MergeInsertionOptions arena;
+
+	BenchmarkConfig() : warmup(2), runs(11) {}
+};
+
+/**
+ * @brief Figures of one engine on one container and distribution.
+ */
+struct BenchmarkResult {
+	SortEngine engine;
+	double median_us;
+	double p95_us;
+	bool counted;
+	unsigned long comparisons;
+	bool correct;
+
+	BenchmarkResult() : engine(ENGINE_AUTO), median_us(0), p95_us(0), counted(false), comparisons(0), correct(true) {}
+};
+
+/**
+ * @brief Wall-clock microseconds elapsed since start, on CLOCK_MONOTONIC.
+ *
+ * clock() measures CPU time, adds up every thread and ticks coarsely on some systems.
+ */
+double elapsed_us(const timespec &start);
+
+/**
+ * @brief Printable name of a distribution.
+ */
+const char *distribution_name(Distribution distribution);
+
+/**
+ * @brief Builds a distribution with as many values as input.
+ *
+ * DIST_INPUT is input itself; the others are generated from a fixed seed, so runs are
+ * reproducible.
+ */
+std::vector<uint32_t> make_distribution(Distribution distribution, const std::vector<uint32_t> &input);
+
+/**
+ * @brief Nearest-rank percentile of samples, for p in (0, 100].
+ */
+double percentile(std::vector<double> samples, double p);
+
+/**
+ * @brief Times every engine on every distribution with std::vector and std::deque.
+ *
+ * The default merge-insertion engine is also timed on std::vector at every SIMD level
+ * the CPU supports, after checking that level's kernels against the scalar ones. The
+ * auto row runs the engine --engine=auto would pick and is named after it.
+ *
+ * @param input The parsed input; its size is the size of every distribution.
+ * @param config Repetitions and arena engine options.
+ * @return Whether every kernel check passed and every sorted result matched std::sort.
+ */
+bool run_benchmark(const std::vector<uint32_t> &input, const BenchmarkConfig &config);
+
+/**
+ * @brief Compares two containers for equality.
+ *
+ * This function compares two containers element-wise to determine if they are equal.
+ *
+ * @tparam T First container type.
+ * @tparam U Second container type, with the same element type.
+ * @param c1 First container.
+ * @param c2 Second container.
+ * @return True if containers are equal, false otherwise.
+ */
+template<typename T, typename U>
+bool compare_containers(const T &c1, const U &c2) {
+	if (c1.size() != c2.size()) {
+		return false;
+	}
+	typename T::const_iterator it1 = c1.begin();
+	typename U::const_iterator it2 = c2.begin();
+	while (it1 != c1.end()) {
+		if (*it1 != *it2) {
+			return false;
+		}
+		++it1;
+		++it2;
+	}
+	return true;
+}
+
+/**
+ * @brief Sorts a container with one benchmark engine, reporting comparisons to policy.
+ */
+template<typename Container, typename CountPolicy>
+void benchmark_sort(Container &container, const BenchmarkEngine &engine, const MergeInsertionOptions &arena,
+	CountPolicy &policy) {
+	CountedCompare<std::less<uint32_t>, CountPolicy> comp(std::less<uint32_t>(), policy);
+
+	if (engine.engine == ENGINE_RADIX) {
+		radix_sort(container.begin(), container.end(), std::less<uint32_t>());
+	} else if (engine.engine == ENGINE_INTROSORT) {
+		introsort(container.begin(), container.end(), comp);
+	} else if (engine.arena) {
+		merge_insertion_sort(container.begin(), container.end(), comp, arena);
+	} else if (engine.chain == CHAIN_VECTOR) {
+		ford_johnson_sort<std::vector<uint32_t> >(container.begin(), container.end(), comp);
+	} else if (engine.chain == CHAIN_DEQUE) {
+		ford_johnson_sort<std::deque<uint32_t> >(container.begin(), container.end(), comp);
+	} else if (engine.chain == CHAIN_TIERED) {
+		ford_johnson_sort<TieredVector<uint32_t> >(container.begin(), container.end(), comp);
+	} else {
+		ford_johnson(container, std::less<uint32_t>(), policy);
+	}
+}
+
+/**
+ * @brief Benchmarks one engine on one container type.
+ *
+ * Every run, warm-up included, sorts a fresh copy of data made outside the timed region.
+ * Timed runs are checked against expected. Comparisons come from one extra, untimed run
+ * with a counting comparator, single-threaded since counting is not thread-safe; the
+ * radix engine makes none and reports no count. ENGINE_AUTO is resolved with
+ * choose_engine() on the container, as --engine=auto does, before the first run.
+ *
+ * @tparam Container std::vector<uint32_t> or std::deque<uint32_t>.
+ * @param setup The engine setup.
+ * @param data The unsorted input.
+ * @param expected data sorted by std::sort.
+ * @param config Repetitions and arena engine options.
+ * @return Engine used, median and p95 times, comparison count and correctness.
+ */
+template<typename Container>
+BenchmarkResult benchmark_engine(const BenchmarkEngine &setup, const std::vector<uint32_t> &data,
+	const std::vector<uint32_t> &expected, const BenchmarkConfig &config) {
+	BenchmarkResult result;
+	NoComparisonCount none;
+	std::vector<double> samples;
+	BenchmarkEngine engine = setup;
+
+	if (engine.engine == ENGINE_AUTO) {
+		Container container(data.begin(), data.end());
+		engine.engine = choose_engine(container.begin(), container.end(), std::less<uint32_t>());
+	}
+	result.engine = engine.engine;
+
+	for (size_t run = 0; run < config.warmup + config.runs; run++) {
+		Container container(data.begin(), data.end());
+		timespec start_time;
+		clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+		benchmark_sort(container, engine, config.arena, none);
+
+		double elapsed = elapsed_us(start_time);
+		if (run >= config.warmup) {
+			samples.push_back(elapsed);
+			result.correct = result.correct && compare_containers(container, expected);
+		}
+	}
+	result.median_us = percentile(samples, 50);
+	result.p95_us = percentile(samples, 95);
+
+	if (engine.engine != ENGINE_RADIX) {
+		Container container(data.begin(), data.end());
+		ComparisonCount counter;
+		MergeInsertionOptions serial = config.arena;
+		serial.threads = 1;
+		benchmark_sort(container, engine, serial, counter);
+		result.counted = true;
+		result.comparisons = counter.count();
+	}
+	return result;
+}
+
+#endif
@@ -0,0 +1,66 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CountingAllocator.cpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "CountingAllocator.hpp"
+
+namespace {
+	AllocationStats global_stats;
+}
+
+/**
+ * @brief The global figures.
+ */
+const AllocationStats &allocation_stats() {
+	return global_stats;
+}
+
+/**
+ * @brief Starts a new measurement: counts restart at zero and the peak at what is live now.
+ */
+void reset_allocation_stats() {
+	global_stats.allocations = 0;
+	global_stats.allocated_bytes = 0;
+	global_stats.baseline_bytes = global_stats.live_bytes;
+	global_stats.peak_bytes = global_stats.live_bytes;
+	global_stats.max_depth = global_stats.depth;
+}
+
+/**
+ * @brief Records a heap block of bytes being allocated.
+ */
+void record_allocation(size_t bytes) {
+	global_stats.allocations++;
+	global_stats.allocated_bytes += bytes;
+	global_stats.live_bytes += bytes;
+	if (global_stats.live_bytes > global_stats.peak_bytes) {
+		global_stats.peak_bytes = global_stats.live_bytes;
+	}
+}
+
+/**
+ * @brief Records a heap block of bytes being freed.
+ */
+void record_deallocation(size_t bytes) {
+	global_stats.live_bytes -= bytes;
+}
+
+RecursionScope::RecursionScope(bool counted) : _counted(counted) {
+	if (_counted && ++global_stats.depth > global_stats.max_depth) {
+		global_stats.max_depth = global_stats.depth;
+	}
+}
+
+RecursionScope::~RecursionScope() {
+	if (_counted) {
+		global_stats.depth--;
+	}
+}
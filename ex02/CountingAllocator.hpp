@@ -0,0 +1,180 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CountingAllocator.hpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef COUNTINGALLOCATOR_HPP
+#define COUNTINGALLOCATOR_HPP
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+/**
+ * @brief Heap figures gathered since the last reset_allocation_stats().
+ *
+ * Fed by every CountingAllocator and by the blocks of SortArena and the radix engine.
+ * The counters are plain integers: they are updated from the calling thread only, never
+ * from ThreadPool workers.
+ */
+struct AllocationStats {
+	unsigned long allocations;
+	size_t allocated_bytes;
+	size_t live_bytes;
+	size_t baseline_bytes;
+	size_t peak_bytes;
+	size_t depth;
+	size_t max_depth;
+
+	AllocationStats()
+		: allocations(0), allocated_bytes(0), live_bytes(0), baseline_bytes(0), peak_bytes(0), depth(0), max_depth(0) {}
+};
+
+/**
+ * @brief The global figures.
+ */
+const AllocationStats &allocation_stats();
+
+/**
+ * @brief Starts a new measurement: counts restart at zero and the peak at what is live now.
+ */
+void reset_allocation_stats();
+
+/**
+ * @brief Records a heap block of bytes being allocated.
+ */
+void record_allocation(size_t bytes);
+
+/**
+ * @brief Records a heap block of bytes being freed.
+ */
+void record_deallocation(size_t bytes);
+
+/**
+ * @class RecursionScope
+ * @brief Counts one recursion level of a sort for as long as it lives.
+ */
+class RecursionScope {
+	public:
+		/**
+		 * @param counted Whether this level is counted at all; sorts pass false outside --memory.
+		 */
+		explicit RecursionScope(bool counted = true);
+
+		~RecursionScope();
+
+	private:
+		bool _counted;
+
+		RecursionScope(const RecursionScope &other);
+
+		RecursionScope &operator=(const RecursionScope &other);
+};
+
+/**
+ * @class CountingAllocator
+ * @brief std::allocator replacement that reports every block to the allocation figures.
+ *
+ * Containers built on it pass it on to the chains of ford_johnson_sort through
+ * ford_johnson_chain, so a sort of such a container accounts for all of its copies.
+ *
+ * @tparam T Element type.
+ */
+template<typename T>
+class CountingAllocator {
+	public:
+		typedef T value_type;
+		typedef T *pointer;
+		typedef const T *const_pointer;
+		typedef T &reference;
+		typedef const T &const_reference;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+
+		template<typename U>
+		struct rebind {
+			typedef CountingAllocator<U> other;
+		};
+
+		CountingAllocator() {}
+
+		template<typename U>
+		CountingAllocator(const CountingAllocator<U> &) {}
+
+		pointer address(reference value) const {
+			return &value;
+		}
+
+		const_pointer address(const_reference value) const {
+			return &value;
+		}
+
+		pointer allocate(size_type n, const void * = 0) {
+			if (n > max_size()) {
+				throw std::bad_alloc();
+			}
+			pointer block = static_cast<pointer>(::operator new(n * sizeof(T)));
+			record_allocation(n * sizeof(T));
+			return block;
+		}
+
+		void deallocate(pointer block, size_type n) {
+			record_deallocation(n * sizeof(T));
+			::operator delete(block);
+		}
+
+		size_type max_size() const {
+			return std::numeric_limits<size_type>::max() / sizeof(T);
+		}
+
+		void construct(pointer p, const T &value) {
+			new (static_cast<void *>(p)) T(value);
+		}
+
+		void destroy(pointer p) {
+			p->~T();
+		}
+};
+
+template<typename T, typename U>
+bool operator==(const CountingAllocator<T> &, const CountingAllocator<U> &) {
+	return true;
+}
+
+template<typename T, typename U>
+bool operator!=(const CountingAllocator<T> &, const CountingAllocator<U> &) {
+	return false;
+}
+
+/**
+ * @class NoRecursionScope
+ * @brief Stand-in for RecursionScope that counts nothing.
+ */
+class NoRecursionScope {
+	public:
+		NoRecursionScope() {}
+};
+
+/**
+ * @brief Scope type a sort uses to count its recursion levels, chosen by the allocator of
+ * its containers: RecursionScope for a CountingAllocator, i.e. under --memory, and
+ * NoRecursionScope for any other, so normal runs keep no depth figures.
+ */
+template<typename Alloc>
+struct recursion_scope {
+	typedef NoRecursionScope type;
+};
+
+template<typename T>
+struct recursion_scope<CountingAllocator<T> > {
+	typedef RecursionScope type;
+};
+
+#endif
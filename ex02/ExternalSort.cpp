@@ -0,0 +1,466 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ExternalSort.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "ExternalSort.hpp"
+#include "SortArena.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+#ifdef __GLIBC__
+# include <malloc.h>
+#endif
+
+namespace {
+	/**
+	 * @brief Key of an exhausted run; larger than every 32-bit value.
+	 */
+	const uint64_t RUN_EXHAUSTED = ~static_cast<uint64_t>(0);
+
+	std::string system_error(const std::string &what) {
+		return what + ": " + std::strerror(errno);
+	}
+
+	void write_all(int fd, const void *data, size_t bytes) {
+		const char *p = static_cast<const char *>(data);
+
+		while (bytes > 0) {
+			ssize_t written = ::write(fd, p, bytes);
+			if (written < 0 && errno == EINTR) {
+				continue;
+			}
+			if (written < 0) {
+				throw std::runtime_error(system_error("Cannot write sorted data"));
+			}
+			p += written;
+			bytes -= written;
+		}
+	}
+
+	/**
+	 * @brief Reads until bytes are read or the file ends.
+	 * @return Bytes read.
+	 */
+	size_t read_full(int fd, void *data, size_t bytes) {
+		char *p = static_cast<char *>(data);
+		size_t total = 0;
+
+		while (total < bytes) {
+			ssize_t got = ::read(fd, p + total, bytes - total);
+			if (got < 0 && errno == EINTR) {
+				continue;
+			}
+			if (got < 0) {
+				throw std::runtime_error(system_error("Cannot read temporary run"));
+			}
+			if (got == 0) {
+				break;
+			}
+			total += got;
+		}
+		return total;
+	}
+
+	void swap_bytes(uint32_t *data, size_t n) {
+		for (size_t i = 0; i < n; i++) {
+			uint32_t v = data[i];
+			data[i] = v >> 24 | (v >> 8 & 0xff00) | (v << 8 & 0xff0000) | v << 24;
+		}
+	}
+
+	/**
+	 * @brief Writes sorted numbers as the little-endian output format; data may be clobbered.
+	 */
+	void write_output(int fd, uint32_t *data, size_t n) {
+		if (!little_endian_host()) {
+			swap_bytes(data, n);
+		}
+		write_all(fd, data, n * sizeof(uint32_t));
+	}
+
+	/**
+	 * @brief A sorted run in a temporary file.
+	 */
+	struct RunFile {
+		int fd;
+		uint64_t count;
+	};
+
+	/**
+	 * @class RunFiles
+	 * @brief Owns the temporary files of one merge level and closes them when destroyed.
+	 *
+	 * Every file is unlinked as soon as it is created, so nothing is left behind on disk
+	 * however the sort ends.
+	 */
+	class RunFiles {
+		public:
+			explicit RunFiles(const std::string &dir) : _dir(dir) {}
+
+			~RunFiles() {
+				for (size_t i = 0; i < _runs.size(); i++) {
+					close(i);
+				}
+			}
+
+			RunFile &create() {
+				std::string path = _dir + "/PmergeMe.XXXXXX";
+				std::vector<char> name(path.begin(), path.end());
+				name.push_back('\0');
+
+				RunFile run;
+				run.fd = ::mkstemp(&name[0]);
+				run.count = 0;
+				if (run.fd < 0) {
+					throw std::runtime_error(system_error("Cannot create temporary file in " + _dir));
+				}
+				::unlink(&name[0]);
+				_runs.push_back(run);
+				return _runs.back();
+			}
+
+			void adopt(const RunFile &run) {
+				_runs.push_back(run);
+			}
+
+			RunFile release(size_t i) {
+				RunFile run = _runs[i];
+				_runs[i].fd = -1;
+				return run;
+			}
+
+			void close(size_t i) {
+				if (_runs[i].fd >= 0) {
+					::close(_runs[i].fd);
+					_runs[i].fd = -1;
+				}
+			}
+
+			void swap(RunFiles &other) {
+				_runs.swap(other._runs);
+			}
+
+			size_t size() const {
+				return _runs.size();
+			}
+
+			RunFile &operator[](size_t i) {
+				return _runs[i];
+			}
+
+		private:
+			std::string _dir;
+			std::vector<RunFile> _runs;
+
+			RunFiles(const RunFiles &other);
+
+			RunFiles &operator=(const RunFiles &other);
+	};
+
+	/**
+	 * @brief Sequential reader over one run, through a slice of the merge memory.
+	 */
+	struct RunReader {
+		int fd;
+		uint32_t *buffer;
+		size_t capacity;
+		size_t pos;
+		size_t end;
+
+		uint64_t next() {
+			if (pos == end) {
+				end = read_full(fd, buffer, capacity * sizeof(uint32_t)) / sizeof(uint32_t);
+				pos = 0;
+				if (end == 0) {
+					return RUN_EXHAUSTED;
+				}
+			}
+			return buffer[pos++];
+		}
+	};
+
+	/**
+	 * @brief Buffered writer of merged numbers.
+	 */
+	struct MergeOutput {
+		int fd;
+		uint32_t *buffer;
+		size_t capacity;
+		size_t used;
+		bool final;
+
+		void put(uint32_t value) {
+			buffer[used++] = value;
+			if (used == capacity) {
+				flush();
+			}
+		}
+
+		void flush() {
+			if (final) {
+				write_output(fd, buffer, used);
+			} else {
+				write_all(fd, buffer, used * sizeof(uint32_t));
+			}
+			used = 0;
+		}
+	};
+
+	/**
+	 * @brief Bytes the run phase needs to sort n numbers with engine.
+	 */
+	uint64_t run_bytes(size_t n, SortEngine engine, const MergeInsertionOptions &options) {
+		uint64_t words = n;
+
+		if (engine == ENGINE_AUTO || engine == ENGINE_RADIX) {
+			words += n;
+		} else if (engine == ENGINE_MERGE_INSERTION) {
+			// the arena, then the buffer the sorted elements are gathered into
+			words += MergeInsertionSort<uint32_t *, std::less<uint32_t> >::requiredWords(n, options) + n;
+		}
+		return words * sizeof(uint32_t);
+	}
+
+	/**
+	 * @brief Sorts one run in memory; scratch holds n words for the radix engine.
+	 * @return The engine that ran.
+	 */
+	SortEngine sort_run(uint32_t *data, size_t n, uint32_t *scratch, SortEngine engine,
+		const MergeInsertionOptions &options) {
+		if (engine == ENGINE_AUTO) {
+			engine = choose_engine(data, data + n, std::less<uint32_t>());
+		}
+		switch (engine) {
+			case ENGINE_RADIX:
+				radix_sort_u32(data, n, scratch);
+				break;
+			case ENGINE_INTROSORT:
+				introsort(data, data + n, std::less<uint32_t>());
+				break;
+			default:
+				merge_insertion_sort(data, data + n, std::less<uint32_t>(), options);
+				break;
+		}
+		return engine;
+	}
+
+	/**
+	 * @brief Merges runs [first, first + count) of runs into output.
+	 *
+	 * Each run reads through its own slice of run_words words of memory.
+	 */
+	void merge_runs(RunFiles &runs, size_t first, size_t count, uint32_t *memory, size_t run_words,
+		MergeOutput &output) {
+		std::vector<RunReader> readers(count);
+		std::vector<uint64_t> keys(count);
+
+		for (size_t i = 0; i < count; i++) {
+			RunReader &reader = readers[i];
+			reader.fd = runs[first + i].fd;
+			reader.buffer = memory + i * run_words;
+			reader.capacity = run_words;
+			reader.pos = 0;
+			reader.end = 0;
+			if (::lseek(reader.fd, 0, SEEK_SET) < 0) {
+				throw std::runtime_error(system_error("Cannot rewind temporary run"));
+			}
+			keys[i] = reader.next();
+		}
+
+		LoserTree tree(&keys[0], count);
+		while (true) {
+			size_t source = tree.winner();
+			if (keys[source] == RUN_EXHAUSTED) {
+				break;
+			}
+			output.put(static_cast<uint32_t>(keys[source]));
+			keys[source] = readers[source].next();
+			tree.replay(source);
+		}
+		output.flush();
+	}
+}
+
+/**
+ * @brief Plays the initial tournament over keys.
+ * @param keys One key per source; must stay valid while the tree is used.
+ * @param k Number of sources, at least 1.
+ */
+LoserTree::LoserTree(const uint64_t *keys, size_t k) : _keys(keys), _k(k), _tree(k) {
+	_tree[0] = k > 1 ? _play(1) : 0;
+}
+
+/**
+ * @brief Index of the source holding the smallest key.
+ */
+size_t LoserTree::winner() const {
+	return _tree[0];
+}
+
+/**
+ * @brief Replays the path of source after its key has changed.
+ *
+ * Leaves sit at implicit positions k..2k-1, so the parent of source is (source + k) / 2.
+ */
+void LoserTree::replay(size_t source) {
+	size_t winner = source;
+
+	for (size_t node = (source + _k) / 2; node > 0; node /= 2) {
+		if (_keys[_tree[node]] < _keys[winner]) {
+			std::swap(_tree[node], winner);
+		}
+	}
+	_tree[0] = winner;
+}
+
+/**
+ * @brief Plays the subtree under node, stores the losers and returns the winner.
+ */
+size_t LoserTree::_play(size_t node) {
+	if (node >= _k) {
+		return node - _k;
+	}
+	size_t left = _play(2 * node);
+	size_t right = _play(2 * node + 1);
+	if (_keys[right] < _keys[left]) {
+		std::swap(left, right);
+	}
+	_tree[node] = right;
+	return left;
+}
+
+/**
+ * @brief Numbers per run that fit the budget together with the scratch memory of engine.
+ *
+ * Merge-insertion addresses elements through 32-bit handles, which caps its runs at
+ * UINT32_MAX numbers.
+ */
+size_t external_run_capacity(size_t budget, SortEngine engine, const MergeInsertionOptions &options) {
+	size_t low = 0;
+	size_t high = budget / sizeof(uint32_t);
+
+	if (engine == ENGINE_MERGE_INSERTION) {
+		high = std::min<size_t>(high, UINT32_MAX);
+	}
+	while (low < high) {
+		size_t mid = low + (high - low + 1) / 2;
+		if (run_bytes(mid, engine, options) <= budget) {
+			low = mid;
+		} else {
+			high = mid - 1;
+		}
+	}
+	return low;
+}
+
+/**
+ * @brief Sorts every number of source into output, using at most config.memory_limit
+ * bytes of buffers.
+ *
+ * Phase one reads runs of external_run_capacity() numbers and writes each one sorted to
+ * its own temporary file; an input that fits in one run goes straight to the output.
+ * Phase two reuses the same budget for the merge: an eighth buffers the output and the
+ * rest is split among the runs being merged. Both phases take their memory from a
+ * SortArena, whose block is not zeroed, so pages a small input never reaches stay
+ * unmapped.
+ */
+ExternalSortStats external_sort(NumberSource &source, int output_fd, const ExternalSortConfig &config) {
+	size_t reserved = source.bufferBytes() + EXTERNAL_SORT_RESERVE;
+	if (config.engine == ENGINE_MERGE_INSERTION && config.merge_insertion.threads > 1) {
+		reserved += (config.merge_insertion.threads - 1) * EXTERNAL_SORT_THREAD_RESERVE;
+	}
+	if (config.memory_limit < EXTERNAL_SORT_MIN_MEMORY + reserved) {
+		throw std::invalid_argument("Memory limit too small for the external sort");
+	}
+
+	const char *tmpdir = std::getenv("TMPDIR");
+	std::string dir = !config.temp_dir.empty() ? config.temp_dir : tmpdir && *tmpdir ? tmpdir : "/tmp";
+	size_t budget = config.memory_limit - reserved;
+	ExternalSortStats stats;
+	RunFiles runs(dir);
+
+	stats.engine = config.engine;
+	stats.run_capacity = external_run_capacity(budget, config.engine, config.merge_insertion);
+	{
+		size_t capacity = stats.run_capacity;
+		bool radix = config.engine == ENGINE_AUTO || config.engine == ENGINE_RADIX;
+		SortArena arena(radix ? 2 * capacity : capacity);
+		uint32_t *block = arena.allocate(capacity);
+		uint32_t *scratch = radix ? arena.allocate(capacity) : NULL;
+
+		while (true) {
+			size_t n = source.read(block, capacity);
+			if (n == 0) {
+				break;
+			}
+			stats.elements += n;
+			stats.engine = sort_run(block, n, scratch, config.engine, config.merge_insertion);
+			if (runs.size() == 0 && n < capacity) {
+				write_output(output_fd, block, n);
+				return stats;
+			}
+			RunFile &run = runs.create();
+			write_all(run.fd, block, n * sizeof(uint32_t));
+			run.count = n;
+			stats.runs++;
+			if (n < capacity) {
+				break;
+			}
+		}
+	}
+	if (runs.size() == 0) {
+		return stats;
+	}
+#ifdef __GLIBC__
+	// The engine's own heap blocks, e.g. the gather buffer of a threaded merge-insertion
+	// run, may still sit freed in the heap; hand them back before the merge maps its buffers.
+	malloc_trim(0);
+#endif
+
+	size_t words = budget / sizeof(uint32_t);
+	size_t output_words = words / 8;
+	size_t input_words = words - output_words;
+	SortArena arena(words);
+	uint32_t *memory = arena.allocate(words);
+	stats.fan_in = std::max<size_t>(2, input_words * sizeof(uint32_t) / EXTERNAL_MERGE_MIN_BUFFER);
+
+	MergeOutput output;
+	output.buffer = memory + input_words;
+	output.capacity = output_words;
+	output.used = 0;
+
+	// Merge just enough of the oldest runs into a new last run to leave fan_in for the final merge.
+	while (runs.size() > stats.fan_in) {
+		size_t count = std::min(stats.fan_in, runs.size() - stats.fan_in + 1);
+		RunFiles merged(dir);
+		for (size_t i = count; i < runs.size(); i++) {
+			merged.adopt(runs.release(i));
+		}
+		RunFile &run = merged.create();
+		output.fd = run.fd;
+		output.final = false;
+		merge_runs(runs, 0, count, memory, input_words / count, output);
+		for (size_t i = 0; i < count; i++) {
+			run.count += runs[i].count;
+		}
+		runs.swap(merged);
+		stats.merges++;
+	}
+
+	output.fd = output_fd;
+	output.final = true;
+	merge_runs(runs, 0, runs.size(), memory, input_words / runs.size(), output);
+	stats.merges++;
+	return stats;
+}
@@ -0,0 +1,138 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ExternalSort.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef EXTERNALSORT_HPP
+#define EXTERNALSORT_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "InputReader.hpp"
+#include "MergeInsertion.hpp"
+#include "SortEngine.hpp"
+
+/**
+ * @brief Smallest memory budget the external sort accepts.
+ */
+const size_t EXTERNAL_SORT_MIN_MEMORY = 1 << 20;
+
+/**
+ * @brief Part of the budget kept back for memory the sort does not allocate itself: code
+ * pages first touched while sorting, stdio buffers and small heap blocks.
+ */
+const size_t EXTERNAL_SORT_RESERVE = 512 << 10;
+
+/**
+ * @brief Part of the budget kept back for each worker thread of a merge-insertion run:
+ * its stack, its malloc arena and the job queue of the ThreadPool.
+ */
+const size_t EXTERNAL_SORT_THREAD_RESERVE = 256 << 10;
+
+/**
+ * @brief Smallest read buffer a run gets during a merge; fewer runs are merged per pass
+ * rather than reading any run in smaller pieces.
+ */
+const size_t EXTERNAL_MERGE_MIN_BUFFER = 256 << 10;
+
+/**
+ * @brief Settings of external_sort().
+ */
+struct ExternalSortConfig {
+	size_t memory_limit;
+	std::string temp_dir;
+	SortEngine engine;
+	MergeInsertionOptions merge_insertion;
+
+	ExternalSortConfig() : memory_limit(64 << 20), temp_dir(), engine(ENGINE_AUTO), merge_insertion() {}
+};
+
+/**
+ * @brief What external_sort() did.
+ */
+struct ExternalSortStats {
+	uint64_t elements;
+	size_t run_capacity;
+	size_t runs;
+	size_t merges;
+	size_t fan_in;
+	SortEngine engine;
+
+	ExternalSortStats()
+		: elements(0), run_capacity(0), runs(0), merges(0), fan_in(0), engine(ENGINE_AUTO) {}
+};
+
+/**
+ * @class LoserTree
+ * @brief Tournament tree that yields the smallest of k keys in O(log k) per step.
+ *
+ * Each internal node keeps the loser of the match played there and node 0 the overall
+ * winner, so replacing the winner's key replays only the matches on its path to the
+ * root, one comparison per level.
+ */
+class LoserTree {
+	public:
+		/**
+		 * @brief Plays the initial tournament over keys.
+		 * @param keys One key per source; must stay valid while the tree is used.
+		 * @param k Number of sources, at least 1.
+		 */
+		LoserTree(const uint64_t *keys, size_t k);
+
+		/**
+		 * @brief Index of the source holding the smallest key.
+		 */
+		size_t winner() const;
+
+		/**
+		 * @brief Replays the path of source after its key has changed.
+		 * @param source Must be the current winner.
+		 */
+		void replay(size_t source);
+
+	private:
+		const uint64_t *_keys;
+		size_t _k;
+		std::vector<size_t> _tree;
+
+		size_t _play(size_t node);
+};
+
+/**
+ * @brief Sorts every number of source into output, using at most config.memory_limit
+ * bytes of buffers.
+ *
+ * Runs that fill the budget are read, sorted in memory by config.engine and written to
+ * unlinked temporary files in config.temp_dir. The runs are then merged through a
+ * LoserTree with one large sequential read buffer each. When the budget cannot give
+ * every run EXTERNAL_MERGE_MIN_BUFFER bytes, the oldest runs are merged into longer runs
+ * first, so every merge reads at that granularity or better.
+ *
+ * The buffers get what is left of config.memory_limit after the block buffer of source,
+ * EXTERNAL_SORT_RESERVE and, for a threaded merge-insertion engine,
+ * EXTERNAL_SORT_THREAD_RESERVE per worker.
+ *
+ * @param source Input numbers; its block buffer counts against the budget.
+ * @param output_fd Receives the sorted numbers as little-endian 32-bit values.
+ * @param config Budget, temporary directory and run engine.
+ * @return Figures describing the sort.
+ * @throws std::invalid_argument If the buffers would get less than EXTERNAL_SORT_MIN_MEMORY.
+ * @throws std::runtime_error If a temporary file or the output cannot be written.
+ */
+ExternalSortStats external_sort(NumberSource &source, int output_fd, const ExternalSortConfig &config);
+
+/**
+ * @brief Numbers per run that fit the budget together with the scratch memory of engine.
+ */
+size_t external_run_capacity(size_t budget, SortEngine engine, const MergeInsertionOptions &options);
+
+#endif
@@ -0,0 +1,328 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FordJohnson.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef FORDJOHNSON_HPP
+#define FORDJOHNSON_HPP
+
+#include <vector>
+#include <deque>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+#include <stdint.h>
+#include "CountingAllocator.hpp"
+#include "SimdKernels.hpp"
+#include "TieredVector.hpp"
+
+/**
+ * @brief Comparison-count policy that records nothing.
+ *
+ * record() compiles to nothing, so the counting hook costs nothing in regular sorts.
+ */
+struct NoComparisonCount {
+	void record() {}
+
+	unsigned long count() const { return 0; }
+};
+
+/**
+ * @brief Comparison-count policy that counts every call to the comparator.
+ */
+struct ComparisonCount {
+	ComparisonCount() : _count(0) {}
+
+	void record() { ++_count; }
+
+	unsigned long count() const { return _count; }
+
+	void reset() { _count = 0; }
+
+	private:
+		unsigned long _count;
+};
+
+/**
+ * @brief Comparator adaptor that reports every comparison to a count policy.
+ *
+ * @tparam Compare The wrapped strict weak ordering.
+ * @tparam CountPolicy NoComparisonCount, ComparisonCount or any type with record().
+ */
+template<typename Compare, typename CountPolicy>
+class CountedCompare {
+	public:
+		CountedCompare(Compare comp, CountPolicy &policy) : _comp(comp), _policy(&policy) {}
+
+		template<typename T>
+		bool operator()(const T &a, const T &b) const {
+			_policy->record();
+			return _comp(a, b);
+		}
+
+	private:
+		Compare _comp;
+		CountPolicy *_policy;
+};
+
+/**
+ * @brief Selects the container used for the main chain while sorting a container.
+ *
+ * Contiguous storage (std::vector) is the default: it has the cheapest binary-search
+ * probes. A std::deque keeps chunked storage so that a deque sort measures chunked
+ * insertion rather than silently sorting a vector, through a TieredVector, whose
+ * chunks make middle insertions O(sqrt n) instead of the O(n) of std::deque::insert.
+ *
+ * @tparam Container The container being sorted.
+ */
+template<typename Container>
+struct ford_johnson_chain {
+	typedef std::vector<typename Container::value_type, typename Container::allocator_type> type;
+};
+
+template<typename T, typename Alloc>
+struct ford_johnson_chain<std::deque<T, Alloc> > {
+	typedef TieredVector<T, Alloc> type;
+};
+
+/**
+ * @brief Inputs of up to this many elements are sorted with insertion sort.
+ */
+const size_t FORD_JOHNSON_INSERTION_THRESHOLD = 16;
+
+/**
+ * @brief Generates the insertion order for the pend elements.
+ *
+ * Generic over the allocator, so that the sequence is allocated like the chains of the
+ * sort using it.
+ *
+ * @param left The left index of the sequence.
+ * @param right The right index of the sequence.
+ * @param sequence The vector to store the generated sequence.
+ */
+template<typename Alloc>
+void generate_insertion_sequence(size_t left, size_t right, std::vector<size_t, Alloc> &sequence) {
+	if (left > right) return;
+	size_t mid = left + (right - left) / 2;
+	sequence.push_back(mid);
+	if (mid > 0) {
+		generate_insertion_sequence(left, mid - 1, sequence);
+	}
+	generate_insertion_sequence(mid + 1, right, sequence);
+}
+
+/**
+ * @brief Reserves room for n elements when the chain supports it.
+ */
+template<typename Chain>
+void reserve_chain(Chain &, size_t) {}
+
+template<typename T, typename Alloc>
+void reserve_chain(std::vector<T, Alloc> &chain, size_t n) {
+	chain.reserve(n);
+}
+
+template<typename T, typename Alloc>
+void reserve_chain(TieredVector<T, Alloc> &chain, size_t n) {
+	chain.reserve(n);
+}
+
+/**
+ * @brief Inserts value into the sorted chain at its lower-bound position.
+ *
+ * @param chain The sorted main chain.
+ * @param value The value to insert.
+ * @param comp The strict weak ordering.
+ */
+template<typename Chain, typename T, typename Compare>
+void binary_insert(Chain &chain, const T &value, Compare comp) {
+	typename Chain::iterator it = std::lower_bound(chain.begin(), chain.end(), value, comp);
+	chain.insert(it, value);
+}
+
+/**
+ * @brief Tiered chain: binary-searches by rank and inserts by rank.
+ */
+template<typename T, typename Alloc, typename Compare>
+void binary_insert(TieredVector<T, Alloc> &chain, const T &value, Compare comp) {
+	chain.insertAt(chain.lowerBound(value, comp), value);
+}
+
+/**
+ * @brief Sorts a small random-access range with straight insertion sort.
+ */
+template<typename RandomIt, typename Compare>
+void insertion_sort(RandomIt first, RandomIt last, Compare comp) {
+	typedef typename std::iterator_traits<RandomIt>::value_type T;
+	typedef typename std::iterator_traits<RandomIt>::difference_type Diff;
+
+	Diff n = last - first;
+	for (Diff i = 1; i < n; i++) {
+		T key = first[i];
+		Diff j = i;
+		while (j > 0 && comp(key, first[j - 1])) {
+			first[j] = first[j - 1];
+			j--;
+		}
+		first[j] = key;
+	}
+}
+
+/**
+ * @brief Appends the larger element of each of the first pair_count pairs to S and the
+ * smaller one to pend, in a single pass.
+ */
+template<typename RandomIt, typename Chain, typename Compare>
+void split_pairs(RandomIt first, size_t pair_count, Chain &S, Chain &pend, Compare comp) {
+	for (size_t i = 0; i < pair_count; i++) {
+		const typename Chain::value_type &a = first[2 * i];
+		const typename Chain::value_type &b = first[2 * i + 1];
+		if (comp(a, b)) {
+			S.push_back(b);
+			pend.push_back(a);
+		} else {
+			S.push_back(a);
+			pend.push_back(b);
+		}
+	}
+}
+
+/**
+ * @brief Uncounted uint32_t in a vector with any allocator: split with min/max vector
+ * instructions.
+ *
+ * max and min give exactly the elements the comparison would pick, since equal
+ * uint32_t values cannot be told apart.
+ */
+template<typename Alloc>
+void split_pairs(typename std::vector<uint32_t, Alloc>::iterator first, size_t pair_count,
+	std::vector<uint32_t, Alloc> &S, std::vector<uint32_t, Alloc> &pend,
+	CountedCompare<std::less<uint32_t>, NoComparisonCount>) {
+	S.resize(pair_count);
+	pend.resize(pair_count);
+	split_pairs_u32(&*first, pair_count, &S[0], &pend[0]);
+}
+
+/**
+ * @brief Sorts a range of at most FORD_JOHNSON_INSERTION_THRESHOLD elements.
+ *
+ * The chain pointer is only a tag naming the chain type of the sort, so the overload
+ * below can pick out ranges of a vector whatever its allocator.
+ */
+template<typename RandomIt, typename Chain, typename Compare>
+void sort_small(RandomIt first, RandomIt last, const Chain *, Compare comp) {
+	insertion_sort(first, last, comp);
+}
+
+/**
+ * @brief Uncounted uint32_t in a vector with any allocator: sorting network in vector
+ * registers.
+ */
+template<typename Alloc>
+void sort_small(typename std::vector<uint32_t, Alloc>::iterator first,
+	typename std::vector<uint32_t, Alloc>::iterator last, const std::vector<uint32_t, Alloc> *,
+	CountedCompare<std::less<uint32_t>, NoComparisonCount>) {
+	sort_small_u32(&*first, static_cast<size_t>(last - first));
+}
+
+/**
+ * @brief Ford-Johnson (merge-insertion) sort over any random-access range.
+ *
+ * Consecutive elements are paired, the larger element of each pair goes into the main
+ * chain S and the smaller one into pend, both in a single pass. S is sorted recursively
+ * and the pend elements are then binary-inserted into it. The pair split and the small
+ * base case go through split_pairs and sort_small, which use SIMD kernels for uncounted
+ * uint32_t in a std::vector, whatever its allocator. Recursion levels are counted for
+ * the allocation figures only when Chain uses a CountingAllocator.
+ *
+ * @tparam Chain Container used for S and pend at every level (see ford_johnson_chain).
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ * @param comp Strict weak ordering on the element type.
+ */
+template<typename Chain, typename RandomIt, typename Compare>
+void ford_johnson_sort(RandomIt first, RandomIt last, Compare comp) {
+
+	size_t n = static_cast<size_t>(last - first);
+	typename recursion_scope<typename Chain::allocator_type>::type level;
+
+	// Base case: 0 or 1 elements are already sorted.
+	if (n <= 1) {
+		return;
+	}
+
+	// Special case: small ranges use insertion sort.
+	if (n <= FORD_JOHNSON_INSERTION_THRESHOLD) {
+		sort_small(first, last, static_cast<const Chain *>(NULL), comp);
+		return;
+	}
+
+	size_t pair_count = n / 2;
+
+	// Split the pairs: the larger element joins S, the smaller one joins pend.
+	Chain S;
+	Chain pend;
+	reserve_chain(S, n);
+	reserve_chain(pend, pair_count);
+	split_pairs(first, pair_count, S, pend, comp);
+
+	// Sort S recursively.
+	ford_johnson_sort<Chain>(S.begin(), S.end(), comp);
+
+	// Insert pend[0], then the remaining pend elements in insertion-sequence order.
+	binary_insert(S, pend[0], comp);
+
+	std::vector<size_t, typename Chain::allocator_type::template rebind<size_t>::other> insertion_sequence;
+	generate_insertion_sequence(1, pend.size() - 1, insertion_sequence);
+	for (size_t i = 0; i < insertion_sequence.size(); i++) {
+		binary_insert(S, pend[insertion_sequence[i]], comp);
+	}
+
+	// If the range has an odd size, insert the unpaired last element.
+	if (n % 2) {
+		binary_insert(S, first[n - 1], comp);
+	}
+
+	// Copy the sorted result back into the range.
+	std::copy(S.begin(), S.end(), first);
+}
+
+/**
+ * @brief Sorts a container with Ford-Johnson, counting comparisons with a policy.
+ *
+ * @tparam Container Any container with random-access iterators.
+ * @tparam Compare Strict weak ordering on Container::value_type.
+ * @tparam CountPolicy Comparison-count policy, chosen at compile time.
+ * @param container The container to sort.
+ * @param comp The comparator.
+ * @param policy Receives one record() call per comparison.
+ */
+template<typename Container, typename Compare, typename CountPolicy>
+void ford_johnson(Container &container, Compare comp, CountPolicy &policy) {
+	typedef typename ford_johnson_chain<Container>::type Chain;
+
+	ford_johnson_sort<Chain>(container.begin(), container.end(), CountedCompare<Compare, CountPolicy>(comp, policy));
+}
+
+/**
+ * @brief Sorts a container with Ford-Johnson using the given comparator.
+ *
+ * @param container The container to sort.
+ * @param comp The comparator.
+ */
+template<typename Container, typename Compare>
+void ford_johnson(Container &container, Compare comp) {
+	NoComparisonCount none;
+
+	ford_johnson(container, comp, none);
+}
+
+#endif
@@ -0,0 +1,366 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   InputReader.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "InputReader.hpp"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Size of the blocks read from a stream.
+ */
+static const size_t READ_BLOCK = 1 << 20;
+
+namespace {
+
+	/**
+	 * @class MappedFile
+	 * @brief Read-only mapping of a whole file, unmapped on destruction.
+	 */
+	class MappedFile {
+		public:
+			explicit MappedFile(const std::string &path) : _data(NULL), _size(0) {
+				int fd = open(path.c_str(), O_RDONLY);
+				if (fd < 0) {
+					throw std::runtime_error("Cannot open " + path + ": " + std::strerror(errno));
+				}
+
+				struct stat info;
+				if (fstat(fd, &info) != 0) {
+					int error = errno;
+					close(fd);
+					throw std::runtime_error("Cannot stat " + path + ": " + std::strerror(error));
+				}
+				_size = static_cast<size_t>(info.st_size);
+
+				// mmap rejects empty mappings; an empty file simply has no data.
+				if (_size > 0) {
+					void *data = mmap(NULL, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+					if (data == MAP_FAILED) {
+						int error = errno;
+						close(fd);
+						throw std::runtime_error("Cannot map " + path + ": " + std::strerror(error));
+					}
+					_data = static_cast<const char *>(data);
+					madvise(data, _size, MADV_SEQUENTIAL);
+				}
+				close(fd);
+			}
+
+			~MappedFile() {
+				if (_data) {
+					munmap(const_cast<char *>(_data), _size);
+				}
+			}
+
+			const char *data() const {
+				return _data;
+			}
+
+			size_t size() const {
+				return _size;
+			}
+
+		private:
+			const char *_data;
+			size_t _size;
+
+			MappedFile(const MappedFile &other);
+
+			MappedFile &operator=(const MappedFile &other);
+	};
+}
+
+/**
+ * @brief Whether the host stores integers little-endian, like the binary input format.
+ */
+bool little_endian_host() {
+	const uint32_t probe = 1;
+
+	return *reinterpret_cast<const unsigned char *>(&probe) == 1;
+}
+
+/**
+ * @brief Parses one number starting at p, with the rules str_to_uint has always applied.
+ *
+ * The digit loop has a single exit test per character; the sign is skipped without a
+ * branch and every validity check is folded into one test after the loop.
+ *
+ * @param p Start of the number; must not point at a separator.
+ * @param end End of the buffer.
+ * @param value Receives the number.
+ * @return Pointer just past the number.
+ * @throws std::invalid_argument If the text is not a valid number.
+ */
+const char *parse_number(const char *p, const char *end, uint32_t &value) {
+	bool negative = *p == '-';
+	p += negative || *p == '+';
+
+	const char *digits = p;
+	uint64_t number = 0;
+	while (p != end) {
+		unsigned digit = static_cast<unsigned char>(*p) - '0';
+		if (digit > 9) {
+			break;
+		}
+		// Leading zeros keep the number at 0, so a long run of them is still valid.
+		number = number * 10 + digit;
+		if (number > UINT32_MAX) {
+			throw std::invalid_argument("Invalid input number");
+		}
+		p++;
+	}
+
+	if (p == digits || (p != end && !is_number_space(*p)) || (negative && number != 0)) {
+		throw std::invalid_argument("Invalid input number");
+	}
+	value = static_cast<uint32_t>(number);
+	return p;
+}
+
+/**
+ * @brief Appends every separator-delimited number of [begin, end) to numbers.
+ * @throws std::invalid_argument If a token is not a valid number.
+ */
+void parse_numbers(const char *begin, const char *end, std::vector<uint32_t> &numbers) {
+	const char *p = begin;
+
+	while (true) {
+		while (p != end && is_number_space(*p)) {
+			p++;
+		}
+		if (p == end) {
+			break;
+		}
+		uint32_t value;
+		p = parse_number(p, end, value);
+		numbers.push_back(value);
+	}
+}
+
+/**
+ * @brief Appends the numbers of a text file, parsed straight from a read-only mapping.
+ * @throws std::runtime_error If the file cannot be opened or mapped.
+ * @throws std::invalid_argument If a token is not a valid number.
+ */
+void read_text_file(const std::string &path, std::vector<uint32_t> &numbers) {
+	MappedFile file(path);
+
+	parse_numbers(file.data(), file.data() + file.size(), numbers);
+}
+
+/**
+ * @brief Appends the numbers read from a file descriptor (e.g. stdin) until end of file.
+ *
+ * Each block is parsed up to its last separator; the cut number, if any, is moved to the
+ * front of the buffer and completed by the next read. The buffer only grows if a single
+ * token is longer than a block.
+ *
+ * @throws std::runtime_error If reading fails.
+ * @throws std::invalid_argument If a token is not a valid number.
+ */
+void read_text_stream(int fd, std::vector<uint32_t> &numbers) {
+	std::vector<char> buffer(READ_BLOCK);
+	size_t carried = 0;
+
+	while (true) {
+		if (buffer.size() - carried < READ_BLOCK / 2) {
+			buffer.resize(buffer.size() * 2);
+		}
+		ssize_t bytes = read(fd, &buffer[carried], buffer.size() - carried);
+		if (bytes < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			throw std::runtime_error(std::string("Cannot read input: ") + std::strerror(errno));
+		}
+
+		const char *begin = &buffer[0];
+		const char *end = begin + carried + bytes;
+		if (bytes == 0) {
+			parse_numbers(begin, end, numbers);
+			return;
+		}
+
+		const char *cut = end;
+		while (cut != begin && !is_number_space(cut[-1])) {
+			cut--;
+		}
+		parse_numbers(begin, cut, numbers);
+		carried = end - cut;
+		std::memmove(&buffer[0], cut, carried);
+	}
+}
+
+/**
+ * @brief Appends the little-endian 32-bit values of a binary file.
+ *
+ * The file is mapped read-only. On a little-endian host the mapping, page-aligned, is
+ * already an array of uint32_t, and numbers is filled from it in the same pass that
+ * grows it, without zeroing the new elements first.
+ *
+ * @throws std::runtime_error If the file cannot be mapped or its size is not a multiple of 4.
+ */
+void read_binary_file(const std::string &path, std::vector<uint32_t> &numbers) {
+	MappedFile file(path);
+
+	if (file.size() % sizeof(uint32_t) != 0) {
+		throw std::runtime_error("Binary input " + path + " is not a whole number of 32-bit values");
+	}
+
+	size_t count = file.size() / sizeof(uint32_t);
+	if (count == 0) {
+		return;
+	}
+	if (little_endian_host()) {
+		const uint32_t *values = reinterpret_cast<const uint32_t *>(file.data());
+		numbers.insert(numbers.end(), values, values + count);
+		return;
+	}
+
+	size_t offset = numbers.size();
+	numbers.resize(offset + count);
+	const unsigned char *bytes = reinterpret_cast<const unsigned char *>(file.data());
+	for (size_t i = 0; i < count; i++, bytes += 4) {
+		numbers[offset + i] = bytes[0] | bytes[1] << 8 | bytes[2] << 16 | static_cast<uint32_t>(bytes[3]) << 24;
+	}
+}
+
+/**
+ * @brief Reads from fd, as text numbers or as little-endian 32-bit values.
+ * @param fd The descriptor; stays owned by the caller.
+ * @param binary Whether the input is binary.
+ * @param buffer_bytes Size of the block buffer.
+ */
+NumberSource::NumberSource(int fd, bool binary, size_t buffer_bytes)
+	: _fd(fd), _binary(binary), _buffer(std::max<size_t>(buffer_bytes, 64)), _pos(0), _end(0), _eof(false) {
+}
+
+/**
+ * @brief Reads up to count numbers into out.
+ * @return Numbers read; fewer than count only at the end of the input.
+ */
+size_t NumberSource::read(uint32_t *out, size_t count) {
+	return _binary ? _readBinary(out, count) : _readText(out, count);
+}
+
+/**
+ * @brief Current size of the block buffer in bytes.
+ */
+size_t NumberSource::bufferBytes() const {
+	return _buffer.size();
+}
+
+/**
+ * @brief Moves the unread bytes to the front and reads more after them.
+ *
+ * The buffer doubles only when it is full of one unfinished token.
+ *
+ * @return False at the end of the input.
+ */
+bool NumberSource::_fill() {
+	if (_eof) {
+		return false;
+	}
+	std::memmove(&_buffer[0], &_buffer[_pos], _end - _pos);
+	_end -= _pos;
+	_pos = 0;
+	if (_end == _buffer.size()) {
+		_buffer.resize(_buffer.size() * 2);
+	}
+
+	while (true) {
+		ssize_t bytes = ::read(_fd, &_buffer[_end], _buffer.size() - _end);
+		if (bytes < 0 && errno == EINTR) {
+			continue;
+		}
+		if (bytes < 0) {
+			throw std::runtime_error(std::string("Cannot read input: ") + std::strerror(errno));
+		}
+		if (bytes == 0) {
+			_eof = true;
+			return false;
+		}
+		_end += bytes;
+		return true;
+	}
+}
+
+/**
+ * @brief Parses numbers, refilling whenever a token may continue past the buffer.
+ */
+size_t NumberSource::_readText(uint32_t *out, size_t count) {
+	size_t produced = 0;
+
+	while (produced < count) {
+		while (_pos < _end && is_number_space(_buffer[_pos])) {
+			_pos++;
+		}
+		if (_pos == _end) {
+			if (!_fill()) {
+				break;
+			}
+			continue;
+		}
+
+		size_t stop = _pos;
+		while (stop < _end && !is_number_space(_buffer[stop])) {
+			stop++;
+		}
+		if (stop == _end) {
+			if (_fill()) {
+				continue;
+			}
+			// At the end of the input _fill() has still moved the last token to the front.
+			stop = _end;
+		}
+		parse_number(&_buffer[_pos], &_buffer[0] + stop, out[produced++]);
+		_pos = stop;
+	}
+	return produced;
+}
+
+/**
+ * @brief Copies whole 32-bit values out of the buffer, swapping bytes on big-endian hosts.
+ */
+size_t NumberSource::_readBinary(uint32_t *out, size_t count) {
+	size_t produced = 0;
+
+	while (produced < count) {
+		if (_end - _pos < sizeof(uint32_t)) {
+			if (_fill()) {
+				continue;
+			}
+			if (_end != _pos) {
+				throw std::runtime_error("Binary input is not a whole number of 32-bit values");
+			}
+			break;
+		}
+
+		size_t values = std::min(count - produced, (_end - _pos) / sizeof(uint32_t));
+		const unsigned char *bytes = reinterpret_cast<const unsigned char *>(&_buffer[_pos]);
+		if (little_endian_host()) {
+			std::memcpy(out + produced, bytes, values * sizeof(uint32_t));
+		} else {
+			for (size_t i = 0; i < values; i++, bytes += 4) {
+				out[produced + i] = bytes[0] | bytes[1] << 8 | bytes[2] << 16 | static_cast<uint32_t>(bytes[3]) << 24;
+			}
+		}
+		produced += values;
+		_pos += values * sizeof(uint32_t);
+	}
+	return produced;
+}
@@ -0,0 +1,125 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   InputReader.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef INPUTREADER_HPP
+#define INPUTREADER_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/**
+ * @brief Whether c separates numbers: the characters std::isspace accepts in the C locale.
+ */
+inline bool is_number_space(char c) {
+	return c == ' ' || static_cast<unsigned char>(c - '\t') < 5;
+}
+
+/**
+ * @brief Whether the host stores integers little-endian, like the binary input format.
+ */
+bool little_endian_host();
+
+/**
+ * @brief Parses one number starting at p, with the rules str_to_uint has always applied.
+ *
+ * An optional '+' or '-' is followed by at least one decimal digit. The value must fit in
+ * 32 bits and may only be negative if it is zero. The number must end at end or at a
+ * separator.
+ *
+ * @param p Start of the number; must not point at a separator.
+ * @param end End of the buffer.
+ * @param value Receives the number.
+ * @return Pointer just past the number.
+ * @throws std::invalid_argument If the text is not a valid number.
+ */
+const char *parse_number(const char *p, const char *end, uint32_t &value);
+
+/**
+ * @brief Appends every separator-delimited number of [begin, end) to numbers.
+ * @throws std::invalid_argument If a token is not a valid number.
+ */
+void parse_numbers(const char *begin, const char *end, std::vector<uint32_t> &numbers);
+
+/**
+ * @brief Appends the numbers of a text file, parsed straight from a read-only mapping.
+ * @throws std::runtime_error If the file cannot be opened or mapped.
+ * @throws std::invalid_argument If a token is not a valid number.
+ */
+void read_text_file(const std::string &path, std::vector<uint32_t> &numbers);
+
+/**
+ * @brief Appends the numbers read from a file descriptor (e.g. stdin) until end of file.
+ *
+ * Reads in large blocks; only a number cut by the end of a block is carried over.
+ *
+ * @throws std::runtime_error If reading fails.
+ * @throws std::invalid_argument If a token is not a valid number.
+ */
+void read_text_stream(int fd, std::vector<uint32_t> &numbers);
+
+/**
+ * @brief Appends the little-endian 32-bit values of a binary file.
+ *
+ * The file is mapped read-only and copied into numbers in a single pass.
+ *
+ * @throws std::runtime_error If the file cannot be mapped or its size is not a multiple of 4.
+ */
+void read_binary_file(const std::string &path, std::vector<uint32_t> &numbers);
+
+/**
+ * @class NumberSource
+ * @brief Pulls numbers from a file descriptor in bounded chunks.
+ *
+ * Unlike the read_* functions, which load a whole input, a NumberSource holds only
+ * its block buffer, so inputs larger than memory can be consumed piecewise.
+ */
+class NumberSource {
+	public:
+		/**
+		 * @brief Reads from fd, as text numbers or as little-endian 32-bit values.
+		 * @param fd The descriptor; stays owned by the caller.
+		 * @param binary Whether the input is binary.
+		 * @param buffer_bytes Size of the block buffer.
+		 */
+		NumberSource(int fd, bool binary, size_t buffer_bytes);
+
+		/**
+		 * @brief Reads up to count numbers into out.
+		 * @return Numbers read; fewer than count only at the end of the input.
+		 * @throws std::runtime_error If reading fails or binary input ends mid-value.
+		 * @throws std::invalid_argument If a token is not a valid number.
+		 */
+		size_t read(uint32_t *out, size_t count);
+
+		/**
+		 * @brief Current size of the block buffer in bytes.
+		 */
+		size_t bufferBytes() const;
+
+	private:
+		int _fd;
+		bool _binary;
+		std::vector<char> _buffer;
+		size_t _pos;
+		size_t _end;
+		bool _eof;
+
+		bool _fill();
+
+		size_t _readText(uint32_t *out, size_t count);
+
+		size_t _readBinary(uint32_t *out, size_t count);
+};
+
+#endif
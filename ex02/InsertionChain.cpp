@@ -0,0 +1,248 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   InsertionChain.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "InsertionChain.hpp"
+#include <algorithm>
+#include <cstring>
+
+/**
+ * @brief Wraps the first size entries of data, which has room for the whole level.
+ * @param data The chain buffer, starting with the sorted main-chain positions.
+ * @param size Number of main-chain positions already in data.
+ * @param group Optional buffer of size words to track the current group's entries.
+ */
+ArrayChain::ArrayChain(uint32_t *data, size_t size, uint32_t *group)
+	: _data(data), _size(size), _initial(size), _group(group), _groupFirst(0), _groupBase(0), _groupSize(0) {}
+
+size_t ArrayChain::size() const {
+	return _size;
+}
+
+uint32_t ArrayChain::at(size_t rank) const {
+	return _data[rank];
+}
+
+/**
+ * @brief Shifts the tail right by one and stores id at rank.
+ *
+ * Entry t of the group (counting from 1) sits at _groupBase + w[1] + ... + w[t] - 1,
+ * where w[t] is one plus the insertions that landed right before it. The Fenwick
+ * descent finds the first entry at or after rank, whose weight takes the insertion.
+ */
+void ArrayChain::insertAt(size_t rank, uint32_t id) {
+	std::memmove(_data + rank + 1, _data + rank, (_size - rank) * sizeof(uint32_t));
+	_data[rank] = id;
+	_size++;
+
+	if (_groupSize == 0) {
+		return;
+	}
+	size_t t = 0;
+	if (rank > _groupBase) {
+		size_t remaining = rank - _groupBase + 1;
+		size_t step = 1;
+		while (step * 2 <= _groupSize) {
+			step *= 2;
+		}
+		for (; step > 0; step /= 2) {
+			if (t + step <= _groupSize && _group[t + step - 1] < remaining) {
+				t += step;
+				remaining -= _group[t - 1];
+			}
+		}
+	}
+	for (t++; t <= _groupSize; t += t & -t) {
+		_group[t - 1]++;
+	}
+}
+
+/**
+ * @brief Starts tracking the initial main-chain entries first..last - 1 (needs group).
+ *
+ * All _size - _initial insertions so far lie before entry first, so entry first + j
+ * sits at rank first + j plus that count: every weight starts at one.
+ */
+void ArrayChain::beginGroup(size_t first, size_t last) {
+	_groupFirst = first;
+	_groupBase = first + _size - _initial;
+	_groupSize = last - first;
+	for (size_t t = 1; t <= _groupSize; t++) {
+		_group[t - 1] = static_cast<uint32_t>(t & -t);
+	}
+}
+
+size_t ArrayChain::bigRank(size_t j) const {
+	size_t sum = 0;
+
+	for (size_t t = j - _groupFirst + 1; t > 0; t -= t & -t) {
+		sum += _group[t - 1];
+	}
+	return _groupBase + sum - 1;
+}
+
+void ArrayChain::flatten(uint32_t *out) const {
+	if (out != _data) {
+		std::memcpy(out, _data, _size * sizeof(uint32_t));
+	}
+}
+
+/**
+ * @brief Builds the tree from the sorted main-chain positions.
+ * @param arena Arena providing RankTree::words(capacity) words.
+ * @param initial The sorted main-chain positions; must stay valid until flatten().
+ * @param size Number of main-chain positions.
+ * @param capacity Number of positions on the level.
+ */
+TreeChain::TreeChain(SortArena &arena, const uint32_t *initial, size_t size, size_t capacity)
+	: _tree(arena, capacity), _initial(initial) {
+	for (size_t j = 0; j < size; j++) {
+		_tree.insertAt(j, initial[j]);
+	}
+}
+
+size_t TreeChain::size() const {
+	return _tree.size();
+}
+
+uint32_t TreeChain::at(size_t rank) const {
+	return _tree.at(rank);
+}
+
+void TreeChain::insertAt(size_t rank, uint32_t id) {
+	_tree.insertAt(rank, id);
+}
+
+void TreeChain::beginGroup(size_t, size_t) {}
+
+size_t TreeChain::bigRank(size_t j) const {
+	return _tree.rank(_initial[j]);
+}
+
+void TreeChain::flatten(uint32_t *out) const {
+	_tree.flatten(out);
+}
+
+/**
+ * @brief Indices handed to one task of a batch scatter.
+ */
+static const size_t BATCH_GRAIN = 1 << 14;
+
+/**
+ * @brief Wraps the first size entries of data, which has room for the whole level.
+ * @param arena Arena providing capacity + size words (spare buffer and ranks).
+ * @param data The chain buffer, starting with the sorted main-chain positions.
+ * @param size Number of main-chain positions already in data.
+ * @param capacity Number of positions on the level.
+ * @param pool Pool running the batch scatters.
+ */
+BatchChain::BatchChain(SortArena &arena, uint32_t *data, size_t size, size_t capacity, ThreadPool &pool)
+	: _data(data), _spare(arena.allocate(capacity)), _size(size), _bigRank(arena.allocate(size)), _bigs(size),
+	_pool(pool), _entries(NULL), _count(0) {
+	for (size_t j = 0; j < _bigs; j++) {
+		_bigRank[j] = static_cast<uint32_t>(j);
+	}
+}
+
+size_t BatchChain::size() const {
+	return _size;
+}
+
+uint32_t BatchChain::at(size_t rank) const {
+	return _data[rank];
+}
+
+/**
+ * @brief Shifts the tail right by one and stores id at rank.
+ */
+void BatchChain::insertAt(size_t rank, uint32_t id) {
+	std::memmove(_data + rank + 1, _data + rank, (_size - rank) * sizeof(uint32_t));
+	_data[rank] = id;
+	_size++;
+
+	uint32_t *shifted = std::lower_bound(_bigRank, _bigRank + _bigs, static_cast<uint32_t>(rank));
+	for (; shifted != _bigRank + _bigs; ++shifted) {
+		++*shifted;
+	}
+}
+
+/**
+ * @brief Inserts count ids at once.
+ *
+ * An entry with gap g that is the j-th of the batch lands at g + j; chain entry p moves
+ * to p plus the number of entries with gap <= p. Both scatters and the rank update run
+ * on the pool.
+ */
+void BatchChain::insertBatch(const uint64_t *entries, size_t count) {
+	_entries = entries;
+	_count = count;
+
+	MethodTask<BatchChain> scatter_entries(*this, &BatchChain::_scatterEntries);
+	MethodTask<BatchChain> scatter_chain(*this, &BatchChain::_scatterChain);
+	MethodTask<BatchChain> shift_ranks(*this, &BatchChain::_shiftRanks);
+	_pool.parallelFor(0, count, BATCH_GRAIN, scatter_entries);
+	_pool.parallelFor(0, _size, BATCH_GRAIN, scatter_chain);
+	_pool.parallelFor(0, _bigs, BATCH_GRAIN, shift_ranks);
+
+	std::swap(_data, _spare);
+	_size += count;
+	_entries = NULL;
+	_count = 0;
+}
+
+size_t BatchChain::bigRank(size_t j) const {
+	return _bigRank[j];
+}
+
+void BatchChain::flatten(uint32_t *out) const {
+	if (out != _data) {
+		std::memcpy(out, _data, _size * sizeof(uint32_t));
+	}
+}
+
+/**
+ * @brief Number of batch entries whose gap is below rank.
+ */
+size_t BatchChain::_entriesBefore(size_t rank) const {
+	return std::lower_bound(_entries, _entries + _count, static_cast<uint64_t>(rank) << 32) - _entries;
+}
+
+void BatchChain::_scatterEntries(size_t begin, size_t end) {
+	for (size_t j = begin; j < end; j++) {
+		_spare[(_entries[j] >> 32) + j] = static_cast<uint32_t>(_entries[j]);
+	}
+}
+
+void BatchChain::_scatterChain(size_t begin, size_t end) {
+	size_t c = _entriesBefore(begin);
+
+	for (size_t p = begin; p < end; p++) {
+		while (c < _count && (_entries[c] >> 32) <= p) {
+			c++;
+		}
+		_spare[p + c] = _data[p];
+	}
+}
+
+void BatchChain::_shiftRanks(size_t begin, size_t end) {
+	if (begin >= end) {
+		return;
+	}
+	size_t c = _entriesBefore(_bigRank[begin]);
+
+	// Ranks are increasing, so one cursor over the entries serves the whole range.
+	for (size_t j = begin; j < end; j++) {
+		while (c < _count && (_entries[c] >> 32) <= _bigRank[j]) {
+			c++;
+		}
+		_bigRank[j] += static_cast<uint32_t>(c);
+	}
+}
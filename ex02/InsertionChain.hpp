@@ -0,0 +1,184 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   InsertionChain.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef INSERTIONCHAIN_HPP
+#define INSERTIONCHAIN_HPP
+
+#include <cstddef>
+#include <stdint.h>
+#include "SortArena.hpp"
+#include "RankTree.hpp"
+#include "ThreadPool.hpp"
+
+/**
+ * @class ArrayChain
+ * @brief Main chain stored as a flat array of positions.
+ *
+ * Lookups are direct, but every insertion shifts the tail of the array, so a full level
+ * of insertions moves O(n^2) entries. Partner ranks are only tracked for the current
+ * Jacobsthal group, in a Fenwick tree over that group: an insertion adds one to every
+ * group entry after it and a lookup sums a prefix, both in O(log n).
+ */
+class ArrayChain {
+	public:
+		/**
+		 * @brief Wraps the first size entries of data, which has room for the whole level.
+		 * @param data The chain buffer, starting with the sorted main-chain positions.
+		 * @param size Number of main-chain positions already in data.
+		 * @param group Optional buffer of size words to track the current group's entries.
+		 */
+		ArrayChain(uint32_t *data, size_t size, uint32_t *group);
+
+		size_t size() const;
+
+		uint32_t at(size_t rank) const;
+
+		void insertAt(size_t rank, uint32_t id);
+
+		/**
+		 * @brief Starts tracking the initial main-chain entries first..last - 1 (needs group).
+		 *
+		 * Every element inserted so far must lie before entry first, as the partners of
+		 * earlier Jacobsthal groups do.
+		 */
+		void beginGroup(size_t first, size_t last);
+
+		/**
+		 * @brief Current rank of the j-th initial main-chain entry, within the current group.
+		 */
+		size_t bigRank(size_t j) const;
+
+		/**
+		 * @brief Writes the chain to out; nothing to do when out is the chain buffer.
+		 */
+		void flatten(uint32_t *out) const;
+
+	private:
+		uint32_t *_data;
+		size_t _size;
+		size_t _initial;
+		uint32_t *_group;
+		size_t _groupFirst;
+		size_t _groupBase;
+		size_t _groupSize;
+};
+
+/**
+ * @class TreeChain
+ * @brief Main chain stored in a RankTree.
+ *
+ * Every lookup by rank costs O(log n), but an insertion moves no other entry, so a full
+ * level of insertions performs O(n log n) work in total, with one final in-order pass.
+ */
+class TreeChain {
+	public:
+		/**
+		 * @brief Builds the tree from the sorted main-chain positions.
+		 * @param arena Arena providing RankTree::words(capacity) words.
+		 * @param initial The sorted main-chain positions; must stay valid until flatten().
+		 * @param size Number of main-chain positions.
+		 * @param capacity Number of positions on the level.
+		 */
+		TreeChain(SortArena &arena, const uint32_t *initial, size_t size, size_t capacity);
+
+		size_t size() const;
+
+		uint32_t at(size_t rank) const;
+
+		void insertAt(size_t rank, uint32_t id);
+
+		/**
+		 * @brief Nothing to do: the tree finds any entry's rank in O(log n).
+		 */
+		void beginGroup(size_t first, size_t last);
+
+		/**
+		 * @brief Current rank of the j-th initial main-chain entry.
+		 */
+		size_t bigRank(size_t j) const;
+
+		/**
+		 * @brief Writes the chain in order to out.
+		 */
+		void flatten(uint32_t *out) const;
+
+	private:
+		RankTree _tree;
+		const uint32_t *_initial;
+};
+
+/**
+ * @class BatchChain
+ * @brief Array chain that can also take a whole group of insertions in one pass.
+ *
+ * Single insertions shift the array like ArrayChain. insertBatch() instead merges a
+ * group whose ranks were all found against the current chain: the chain and the group
+ * are scattered into a second buffer in parallel and the buffers swap, so a group of
+ * any size costs O(n) moves spread across the pool.
+ */
+class BatchChain {
+	public:
+		/**
+		 * @brief Wraps the first size entries of data, which has room for the whole level.
+		 * @param arena Arena providing capacity + size words (spare buffer and ranks).
+		 * @param data The chain buffer, starting with the sorted main-chain positions.
+		 * @param size Number of main-chain positions already in data.
+		 * @param capacity Number of positions on the level.
+		 * @param pool Pool running the batch scatters.
+		 */
+		BatchChain(SortArena &arena, uint32_t *data, size_t size, size_t capacity, ThreadPool &pool);
+
+		size_t size() const;
+
+		uint32_t at(size_t rank) const;
+
+		void insertAt(size_t rank, uint32_t id);
+
+		/**
+		 * @brief Inserts count ids at once.
+		 *
+		 * entries[j] holds gap << 32 | id, where gap is the rank the id would get in the
+		 * chain as it is now. Entries must be sorted by gap, and entries sharing a gap
+		 * must already be in their final relative order.
+		 */
+		void insertBatch(const uint64_t *entries, size_t count);
+
+		/**
+		 * @brief Current rank of the j-th initial main-chain entry.
+		 */
+		size_t bigRank(size_t j) const;
+
+		/**
+		 * @brief Writes the chain to out; nothing to do when out holds the chain.
+		 */
+		void flatten(uint32_t *out) const;
+
+	private:
+		uint32_t *_data;
+		uint32_t *_spare;
+		size_t _size;
+		uint32_t *_bigRank;
+		size_t _bigs;
+		ThreadPool &_pool;
+		const uint64_t *_entries;
+		size_t _count;
+
+		size_t _entriesBefore(size_t rank) const;
+
+		void _scatterEntries(size_t begin, size_t end);
+
+		void _scatterChain(size_t begin, size_t end);
+
+		void _shiftRanks(size_t begin, size_t end);
+};
+
+#endif
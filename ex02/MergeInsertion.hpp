@@ -0,0 +1,821 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MergeInsertion.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef MERGEINSERTION_HPP
+#define MERGEINSERTION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <iterator>
+#include <vector>
+#include <stdint.h>
+#include "CountingAllocator.hpp"
+#include "SortArena.hpp"
+#include "InsertionChain.hpp"
+#include "ThreadPool.hpp"
+
+/**
+ * @brief Levels of up to this many handles are sorted with insertion sort.
+ */
+const size_t MERGE_INSERTION_THRESHOLD = 16;
+
+/**
+ * @brief With several threads, levels of at least this many pairs run in parallel.
+ */
+const size_t MERGE_INSERTION_PARALLEL_PAIRS = 1 << 13;
+
+/**
+ * @brief Jacobsthal groups of at least this many elements are placed as one batch.
+ */
+const size_t MERGE_INSERTION_PARALLEL_GROUP = 1 << 11;
+
+/**
+ * @brief Indices handed to one task of a parallel loop.
+ */
+const size_t MERGE_INSERTION_PARALLEL_GRAIN = 1 << 12;
+
+/**
+ * @brief Order in which the pend elements are inserted into the main chain.
+ *
+ * MIDPOINT_ORDER keeps the historical midpoint-recursive order with searches over the
+ * whole chain and an insertion-sort base case. JACOBSTHAL_ORDER is the textbook
+ * Ford-Johnson schedule: pend elements are inserted in Jacobsthal groups, each search is
+ * bounded by the current position of the element's partner, and the recursion runs all
+ * the way down so the worst case matches the Ford-Johnson comparison bound.
+ */
+enum InsertionOrder {
+	MIDPOINT_ORDER,
+	JACOBSTHAL_ORDER
+};
+
+/**
+ * @brief Data structure holding the main chain while pend elements are inserted.
+ *
+ * ARRAY_CHAIN shifts a flat array on every insertion (O(n^2) moves per level).
+ * TREE_CHAIN keeps the chain in an order-statistic tree (O(n log n) work per level) and
+ * scatters it back once. Both probe the same ranks, so comparisons are identical.
+ */
+enum ChainStrategy {
+	ARRAY_CHAIN,
+	TREE_CHAIN
+};
+
+/**
+ * @brief Tuning of MergeInsertionSort.
+ *
+ * count_depth makes every recursion level report to the allocation figures; --memory
+ * turns it on.
+ */
+struct MergeInsertionOptions {
+	InsertionOrder order;
+	ChainStrategy chain;
+	size_t threads;
+	bool count_depth;
+
+	MergeInsertionOptions(InsertionOrder order = MIDPOINT_ORDER, ChainStrategy chain = ARRAY_CHAIN,
+		size_t threads = 1)
+		: order(order), chain(chain), threads(threads), count_depth(false) {}
+};
+
+/**
+ * @brief Worst-case comparison count of Ford-Johnson, F(n) = sum of ceil(log2(3k/4)).
+ */
+unsigned long ford_johnson_bound(size_t n);
+
+/**
+ * @brief Information-theoretic lower bound on comparisons, ceil(log2(n!)).
+ */
+unsigned long comparison_lower_bound(size_t n);
+
+/**
+ * @brief Writes the pend insertion order for [left, right] into out and advances it.
+ *
+ * Same order as generate_insertion_sequence, but without allocating.
+ *
+ * @param left The left index of the sequence.
+ * @param right The right index of the sequence.
+ * @param out Destination cursor, advanced past the written indices.
+ */
+void fill_insertion_sequence(size_t left, size_t right, uint32_t *&out);
+
+/**
+ * @brief Memory figures reported by an arena-backed sort.
+ *
+ * allocations is measured: the blocks the sort reported to allocation_stats(), i.e. its
+ * SortArena and, when it moves the elements, the gather buffer. The threads and queues
+ * of the ThreadPool are not included.
+ */
+struct MergeInsertionStats {
+	unsigned long allocations;
+	size_t reserved_bytes;
+	size_t peak_bytes;
+
+	MergeInsertionStats() : allocations(0), reserved_bytes(0), peak_bytes(0) {}
+};
+
+/**
+ * @brief Rearranges [first, last) so that element i becomes the old element order[i].
+ *
+ * Follows each cycle of the permutation once, holding a single element aside, so every
+ * element is moved exactly once. Visited entries of order are reset to fixed points,
+ * which leaves order as the identity afterwards.
+ *
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ * @param order A permutation of 0..n-1, e.g. from merge_insertion_order().
+ */
+template<typename RandomIt>
+void apply_permutation(RandomIt first, RandomIt last, uint32_t *order) {
+	typedef typename std::iterator_traits<RandomIt>::value_type T;
+
+	size_t n = static_cast<size_t>(last - first);
+	for (size_t i = 0; i < n; i++) {
+		if (order[i] == i) {
+			continue;
+		}
+		T held = first[i];
+		size_t j = i;
+		while (true) {
+			size_t next = order[j];
+			order[j] = static_cast<uint32_t>(j);
+			if (next == i) {
+				first[j] = held;
+				break;
+			}
+			first[j] = first[next];
+			j = next;
+		}
+	}
+}
+
+/**
+ * @class MergeInsertionSort
+ * @brief Allocation-free Ford-Johnson sort driven by index arrays.
+ *
+ * The elements are never copied during the recursion. Each level works on an array of
+ * 32-bit handles into the input and produces the sorted order of its positions, so the
+ * partner of every main-chain element is known without carrying pairs around. All index
+ * arrays come from one SortArena sized from n before the sort starts. The elements are
+ * then gathered in sorted order into a buffer of n copies, in one sequential pass that
+ * reads the input through the order array, and copied back.
+ *
+ * Memory bound: the arena holds 2n words for the top-level handles and order. A level of
+ * k pairs keeps 2k words (bigger halves and their sorted order) across its recursive
+ * call, then briefly 2k more once the deeper levels have been released: pend plus either
+ * the insertion sequence or the partner ranks of the current Jacobsthal group. The k
+ * halve at every level, so the peak stays below 4n words, i.e. 16 bytes per element,
+ * in one heap allocation, plus the gather buffer at the end. TREE_CHAIN adds 4m words of
+ * tree nodes on a level of m positions, which raises the bound to 8n words (32 bytes
+ * per element).
+ *
+ * Threads: with options.threads > 1, every level of at least
+ * MERGE_INSERTION_PARALLEL_PAIRS pairs forms its pairs and splits the sorted pairs on a
+ * ThreadPool, and inserts its pend elements in Jacobsthal groups whatever the configured
+ * order. A large group is placed as a batch: each element's bounded search runs in
+ * parallel against the chain as it was before the group, elements that fall into the
+ * same gap are ordered among themselves, and a BatchChain scatters everything into place.
+ * The result is the same sorted sequence as the serial engine, but the comparison
+ * schedule differs, so the comparator must be safe to call concurrently and must not
+ * count. Such levels add a spare chain buffer and two key arrays, at most 7k words, and
+ * the final gather and copy back are split across the pool.
+ *
+ * @tparam RandomIt Random-access iterator over the input.
+ * @tparam Compare Strict weak ordering on the element type.
+ */
+template<typename RandomIt, typename Compare>
+class MergeInsertionSort {
+	public:
+		MergeInsertionSort(RandomIt first, RandomIt last, Compare comp,
+			const MergeInsertionOptions &options = MergeInsertionOptions());
+
+		void sort();
+
+		void sortOrder(uint32_t *order);
+
+		const MergeInsertionStats &stats() const;
+
+		static size_t requiredWords(size_t n, const MergeInsertionOptions &options = MergeInsertionOptions());
+
+	private:
+		typedef typename std::iterator_traits<RandomIt>::value_type value_type;
+
+		RandomIt _first;
+		size_t _n;
+		Compare _comp;
+		MergeInsertionOptions _options;
+		SortArena *_arena;
+		ThreadPool *_pool;
+		MergeInsertionStats _stats;
+
+		struct ParallelLevel {
+			const uint32_t *handles;
+			uint32_t *big;
+			const uint32_t *sub;
+			uint32_t *order;
+			uint32_t *partners;
+			const uint32_t *pend;
+			const BatchChain *chain;
+			uint64_t *keys;
+			size_t k;
+			size_t top;
+		};
+
+		ParallelLevel _level;
+		value_type *_gathered;
+
+		bool _less(uint32_t a, uint32_t b);
+
+		void _sortLevel(const uint32_t *handles, size_t m, uint32_t *order);
+
+		void _sortLevelParallel(const uint32_t *handles, size_t m, uint32_t *order);
+
+		void _insertBatched(const uint32_t *handles, BatchChain &chain, size_t k, const uint32_t *pend, bool odd);
+
+		void _pairRange(size_t begin, size_t end);
+
+		void _splitRange(size_t begin, size_t end);
+
+		void _searchRange(size_t begin, size_t end);
+
+		uint32_t _groupPosition(size_t e) const;
+
+		template<typename Chain>
+		void _insertMidpoint(const uint32_t *handles, Chain &chain, size_t k, const uint32_t *pend, bool odd);
+
+		template<typename Chain>
+		void _insertJacobsthal(const uint32_t *handles, Chain &chain, size_t k, const uint32_t *pend, bool odd);
+
+		template<typename Chain>
+		size_t _search(const uint32_t *handles, const Chain &chain, size_t bound, uint32_t position);
+
+		static size_t _threshold(InsertionOrder order);
+
+		void _run(uint32_t *out);
+
+		void _sortAll(uint32_t *out);
+
+		void _gatherPermutation(uint32_t *order);
+
+		void _gatherRange(size_t begin, size_t end);
+
+		void _storeRange(size_t begin, size_t end);
+};
+
+/**
+ * @brief Prepares a sort of [first, last).
+ */
+template<typename RandomIt, typename Compare>
+MergeInsertionSort<RandomIt, Compare>::MergeInsertionSort(RandomIt first, RandomIt last, Compare comp,
+	const MergeInsertionOptions &options)
+	: _first(first), _n(static_cast<size_t>(last - first)), _comp(comp), _options(options), _arena(NULL), _pool(NULL), _gathered(NULL) {
+}
+
+/**
+ * @brief Sorts the range in place.
+ * @throws std::length_error if the range has more elements than a 32-bit handle can address.
+ */
+template<typename RandomIt, typename Compare>
+void MergeInsertionSort<RandomIt, Compare>::sort() {
+	if (_n > 1) {
+		_run(NULL);
+	}
+}
+
+/**
+ * @brief Computes the sorted order without moving any element.
+ *
+ * Only the comparator reads the elements, so records of any size stay where they are;
+ * apply_permutation() or a gather can move them afterwards, once each.
+ *
+ * @param order Receives n positions: order[i] is the index of the i-th smallest element.
+ * @throws std::length_error if the range has more elements than a 32-bit handle can address.
+ */
+template<typename RandomIt, typename Compare>
+void MergeInsertionSort<RandomIt, Compare>::sortOrder(uint32_t *order) {
+	if (_n == 1) {
+		order[0] = 0;
+	} else if (_n > 1) {
+		_run(order);
+	}
+}
+
+/**
+ * @brief Runs the sort; writes the order to out, or applies it to the input if out is NULL.
+ */
+template<typename RandomIt, typename Compare>
+void MergeInsertionSort<RandomIt, Compare>::_run(uint32_t *out) {
+	if (_n > UINT32_MAX) {
+		throw std::length_error("MergeInsertionSort: too many elements");
+	}
+
+	// Threads only pay off once the top level is large enough to run in parallel, and
+	// serial sorts never start a pool.
+	bool parallel = _options.threads > 1 && _n / 2 >= MERGE_INSERTION_PARALLEL_PAIRS;
+	unsigned long allocations = allocation_stats().allocations;
+	SortArena arena(requiredWords(_n, _options));
+	_arena = &arena;
+	_stats.reserved_bytes = arena.capacityBytes();
+
+	if (parallel) {
+		ThreadPool pool(_options.threads);
+		_pool = &pool;
+		_sortAll(out);
+		_pool = NULL;
+	} else {
+		_sortAll(out);
+	}
+
+	_stats.peak_bytes = arena.peakBytes();
+	_stats.allocations = allocation_stats().allocations - allocations;
+	_arena = NULL;
+}
+
+/**
+ * @brief Sorts the handles of the whole input with the arena and pool set up by _run.
+ */
+template<typename RandomIt, typename Compare>
+void MergeInsertionSort<RandomIt, Compare>::_sortAll(uint32_t *out) {
+	uint32_t *handles = _arena->allocate(_n);
+	uint32_t *order = _arena->allocate(_n);
+	for (size_t i = 0; i < _n; i++) {
+		handles[i] = static_cast<uint32_t>(i);
+	}
+
+	_sortLevel(handles, _n, order);
+	if (out) {
+		std::copy(order, order + _n, out);
+	} else {
+		_gatherPermutation(order);
+	}
+}
+
+/**
+ * @brief Allocation and memory figures of the last sort().
+ */
+template<typename RandomIt, typename Compare>
+const MergeInsertionStats &MergeInsertionSort<RandomIt, Compare>::stats() const {
+	return _stats;
+}
+
+/**
+ * @brief Arena size, in 32-bit words, needed to sort n elements.
+ *
+ * Walks the recursion levels the same way _sortLevel allocates and releases.
+ */
+template<typename RandomIt, typename Compare>
+size_t MergeInsertionSort<RandomIt, Compare>::requiredWords(size_t n, const MergeInsertionOptions &options) {
+	size_t held = 2 * n;
+	size_t peak = held;
+
+	for (size_t m = n; m > _threshold(options.order); m /= 2) {
+		size_t k = m / 2;
+		held += 2 * k;
+
+		if (options.threads > 1 && k >= MERGE_INSERTION_PARALLEL_PAIRS) {
+			// pend, spare buffer and ranks, then keys and scratch (at most k each, padded)
+			peak = std::max(peak, held + k + m + k + 4 * k + 1);
+			continue;
+		}
+
+		// pend, the chain structure, then the midpoint sequence
+		size_t level = k;
+		if (options.chain == TREE_CHAIN) {
+			level += RankTree::words(m);
+		} else if (options.order == JACOBSTHAL_ORDER) {
+			level += k;
+		}
+		if (options.order == MIDPOINT_ORDER) {
+			level += k - 1;
+		}
+		peak = std::max(peak, held + level);
+	}
+	return peak;
+}
+
+template<typename RandomIt, typename Compare>
+bool MergeInsertionSort<RandomIt, Compare>::_less(uint32_t a, uint32_t b) {
+	return _comp(_first[a], _first[b]);
+}
+
+template<typename RandomIt, typename Compare>
+size_t MergeInsertionSort<RandomIt, Compare>::_threshold(InsertionOrder order) {
+	return order == JACOBSTHAL_ORDER ? 1 : MERGE_INSERTION_THRESHOLD;
+}
+
+/**
+ * @brief Computes the sorted order of one recursion level.
+ *
+ * @param handles The m input indices of this level.
+ * @param m Number of handles.
+ * @param order Receives the positions 0..m-1 of handles, sorted by the values they refer to.
+ */
+template<typename RandomIt, typename Compare>
+void MergeInsertionSort<RandomIt, Compare>::_sortLevel(const uint32_t *handles, size_t m, uint32_t *order) {
+	RecursionScope level(_options.count_depth);
+
+	// Small levels: straight insertion sort of the positions.
+	if (m <= _threshold(_options.order)) {
+		for (size_t i = 0; i < m; i++) {
+			uint32_t key = static_cast<uint32_t>(i);
+			size_t j = i;
+			while (j > 0 && _less(handles[key], handles[order[j - 1]])) {
+				order[j] = order[j - 1];
+				j--;
+			}
+			order[j] = key;
+		}
+		return;
+	}
+	if (_pool && m / 2 >= MERGE_INSERTION_PARALLEL_PAIRS) {
+		_sortLevelParallel(handles, m, order);
+		return;
+	}
+
+	size_t k = m / 2;
+	size_t mark = _arena->mark();
+
+	// Keep the larger handle of every pair and sort those recursively.
+	uint32_t *big = _arena->allocate(k);
+	for (size_t i = 0; i < k; i++) {
+		big[i] = _less(handles[2 * i], handles[2 * i + 1]) ? handles[2 * i + 1] : handles[2 * i];
+	}
+
+	uint32_t *sub = _arena->allocate(k);
+	_sortLevel(big, k, sub);
+
+	// The sorted pairs become the main chain; pend[j] is the partner of chain[j].
+	uint32_t *pend = _arena->allocate(k);
+	for (size_t j = 0; j < k; j++) {
+		uint32_t p = sub[j];
+		bool first_is_big = handles[2 * p] == big[p];
+		order[j] = first_is_big ? 2 * p : 2 * p + 1;
+		pend[j] = first_is_big ? 2 * p + 1 : 2 * p;
+	}
+
+	bool odd = m % 2;
+	if (_options.chain == TREE_CHAIN) {
+		TreeChain chain(*_arena, order, k, m);
+		if (_options.order == JACOBSTHAL_ORDER) {
+			_insertJacobsthal(handles, chain, k, pend, odd);
+		} else {
+			_insertMidpoint(handles, chain, k, pend, odd);
+		}
+		chain.flatten(order);
+	} else if (_options.order == JACOBSTHAL_ORDER) {
+		ArrayChain chain(order, k, _arena->allocate(k));
+		_insertJacobsthal(handles, chain, k, pend, odd);
+	} else {
+		ArrayChain chain(order, k, NULL);
+		_insertMidpoint(handles, chain, k, pend, odd);
+	}
+
+	_arena->release(mark);
+}
+
+/**
+ * @brief Same steps as _sortLevel, with the loops and the pend insertion on the pool.
+ *
+ * The shared state of a loop lives in _level and is set right before the loop, since
+ * the recursive call reuses it.
+ */
+template<typename RandomIt, typename Compare>
+void MergeInsertionSort<RandomIt, Compare>::_sortLevelParallel(const uint32_t *handles, size_t m, uint32_t *order) {
+	size_t k = m / 2;
+	size_t mark = _arena->mark();
+
+	uint32_t *big = _arena->allocate(k);
+	_level.handles = handles;
+	_level.big = big;
+	MethodTask<MergeInsertionSort> pairing(*this, &MergeInsertionSort::_pairRange);
+	_pool->parallelFor(0, k, MERGE_INSERTION_PARALLEL_GRAIN, pairing);
+
+	uint32_t *sub = _arena->allocate(k);
+	_sortLevel(big, k, sub);
+
+	uint32_t *pend = _arena->allocate(k);
+	_level.handles = handles;
+	_level.big = big;
+	_level.sub = sub;
+	_level.order = order;
+	_level.partners = pend;
+	MethodTask<MergeInsertionSort> split(*this, &MergeInsertionSort::_splitRange);
+	_pool->parallelFor(0, k, MERGE_INSERTION_PARALLEL_GRAIN, split);
+
+	BatchChain chain(*_arena, order, k, m, *_pool);
+	_insertBatched(handles, chain, k, pend, m % 2);
+	chain.flatten(order);
+
+	_arena->release(mark);
+}
+
+/**
+ * @brief Inserts the pend elements in Jacobsthal groups, placing large groups as batches.
+ *
+ * Small groups go one by one exactly like _insertJacobsthal. For a large group, every
+ * element is searched for in parallel within the chain before its partner, as the chain
+ * stood before the group; the resulting gap << 32 | index keys are sorted, elements
+ * sharing a gap are put in order with a few extra comparisons, and the group is merged
+ * into the chain in one pass.
+ *
+ * @param handles The input indices of this level.
+ * @param chain Holds the k sorted main-chain positions.
+ * @param k Number of pairs.
+ * @param pend pend[j] is the position of the partner of the j-th main-chain entry.
+ * @param odd Whether the last position of the level is unpaired.
+ */
+template<typename RandomIt, typename Compare>
+void MergeInsertionSort<RandomIt, Compare>::_insertBatched(const uint32_t *handles, BatchChain &chain, size_t k,
+	const uint32_t *pend, bool odd) {
+	chain.insertAt(0, pend[0]);
+
+	size_t total = k + (odd ? 1 : 0);
+	size_t done = 1;
+	size_t previous = 1;
+	while (done < total) {
+		size_t next = done + 2 * previous;
+		size_t top = std::min(next, total);
+		previous = done;
+
+		if (top - done < MERGE_INSERTION_PARALLEL_GROUP) {
+			for (size_t i = top; i > done; i--) {
+				uint32_t position = i <= k ? pend[i - 1] : static_cast<uint32_t>(2 * k);
+				size_t bound = i <= k ? chain.bigRank(i - 1) : chain.size();
+				chain.insertAt(_search(handles, chain, bound, position), position);
+			}
+			done = next;
+			continue;
+		}
+
+		size_t count = top - done;
+		size_t mark = _arena->mark();
+		uint64_t *keys = _arena->allocateWide(count);
+		uint64_t *scratch = _arena->allocateWide(count);
+
+		_level.handles = handles;
+		_level.pend = pend;
+		_level.chain = &chain;
+		_level.keys = keys;
+		_level.k = k;
+		_level.top = top;
+		MethodTask<MergeInsertionSort> search(*this, &MergeInsertionSort::_searchRange);
+		_pool->parallelFor(0, count, MERGE_INSERTION_PARALLEL_GRAIN, search);
+		parallel_sort(keys, scratch, count, *_pool);
+
+		// Replace indices by positions, then order every run of a shared gap by value.
+		size_t run = 0;
+		for (size_t j = 0; j < count; j++) {
+			uint64_t gap = keys[j] >> 32;
+			keys[j] = gap << 32 | _groupPosition(static_cast<size_t>(keys[j] & UINT32_MAX));
+			if (j > 0 && gap != keys[j - 1] >> 32) {
+				run = j;
+			}
+			for (size_t r = j; r > run && _less(handles[static_cast<uint32_t>(keys[r])],
+				handles[static_cast<uint32_t>(keys[r - 1])]); r--) {
+				std::swap(keys[r], keys[r - 1]);
+			}
+		}
+		chain.insertBatch(keys, count);
+
+		_arena->release(mark);
+		done = next;
+	}
+}
+
+template<typename RandomIt, typename Compare>
+void MergeInsertionSort<RandomIt, Compare>::_pairRange(size_t begin, size_t end) {
+	const uint32_t *handles = _level.handles;
+
+	for (size_t i = begin; i < end; i++) {
+		_level.big[i] = _less(handles[2 * i], handles[2 * i + 1]) ? handles[2 * i + 1] : handles[2 * i];
+	}
+}
+
+template<typename RandomIt, typename Compare>
+void MergeInsertionSort<RandomIt, Compare>::_splitRange(size_t begin, size_t end) {
+	for (size_t j = begin; j < end; j++) {
+		uint32_t p = _level.sub[j];
+		bool first_is_big = _level.handles[2 * p] == _level.big[p];
+		_level.order[j] = first_is_big ? 2 * p : 2 * p + 1;
+		_level.partners[j] = first_is_big ? 2 * p + 1 : 2 * p;
+	}
+}
+
+/**
+ * @brief Bounded searches of the group elements top - begin down to top - end + 1.
+ */
+template<typename RandomIt, typename Compare>
+void MergeInsertionSort<RandomIt, Compare>::_searchRange(size_t begin, size_t end) {
+	const BatchChain &chain = *_level.chain;
+
+	for (size_t e = begin; e < end; e++) {
+		size_t i = _level.top - e;
+		size_t bound = i <= _level.k ? chain.bigRank(i - 1) : chain.size();
+		uint64_t gap = _search(_level.handles, chain, bound, _groupPosition(e));
+		_level.keys[e] = gap << 32 | e;
+	}
+}
+
+/**
+ * @brief Position of the e-th element of the current group, counting down from its top.
+ */
+template<typename RandomIt, typename Compare>
+uint32_t MergeInsertionSort<RandomIt, Compare>::_groupPosition(size_t e) const {
+	size_t i = _level.top - e;
+
+	return i <= _level.k ? _level.pend[i - 1] : static_cast<uint32_t>(2 * _level.k);
+}
+
+/**
+ * @brief Inserts pend[0], then the rest in midpoint order, each over the whole chain.
+ *
+ * @param handles The input indices of this level.
+ * @param chain Holds the k sorted main-chain positions.
+ * @param k Number of pairs.
+ * @param pend pend[j] is the position of the partner of the j-th main-chain entry.
+ * @param odd Whether the last position of the level is unpaired.
+ */
+template<typename RandomIt, typename Compare>
+template<typename Chain>
+void MergeInsertionSort<RandomIt, Compare>::_insertMidpoint(const uint32_t *handles, Chain &chain, size_t k,
+	const uint32_t *pend, bool odd) {
+	chain.insertAt(_search(handles, chain, chain.size(), pend[0]), pend[0]);
+
+	uint32_t *sequence = _arena->allocate(k - 1);
+	uint32_t *cursor = sequence;
+	fill_insertion_sequence(1, k - 1, cursor);
+	for (uint32_t *it = sequence; it != cursor; ++it) {
+		chain.insertAt(_search(handles, chain, chain.size(), pend[*it]), pend[*it]);
+	}
+
+	// If the level has an odd size, insert the unpaired last position.
+	if (odd) {
+		uint32_t last = static_cast<uint32_t>(2 * k);
+		chain.insertAt(_search(handles, chain, chain.size(), last), last);
+	}
+}
+
+/**
+ * @brief Inserts the pend elements in Jacobsthal groups with bounded searches.
+ *
+ * With the partners numbered a1..ak (plus the unpaired element as a(k+1)), a1 goes in
+ * front of the chain for free, then the groups (3..2], (5..4], (11..6], (21..12], ...
+ * are each inserted from their highest index down. Every ai is searched for only in the
+ * part of the chain before its partner bi, whose rank the chain tracks as earlier
+ * insertions of the same group shift it; the unpaired element searches the whole chain. Each group then
+ * needs at most one more comparison per element than the previous one.
+ *
+ * @param handles The input indices of this level.
+ * @param chain Holds the k sorted main-chain positions.
+ * @param k Number of pairs.
+ * @param pend pend[j] is the position of the partner of the j-th main-chain entry.
+ * @param odd Whether the last position of the level is unpaired.
+ */
+template<typename RandomIt, typename Compare>
+template<typename Chain>
+void MergeInsertionSort<RandomIt, Compare>::_insertJacobsthal(const uint32_t *handles, Chain &chain, size_t k,
+	const uint32_t *pend, bool odd) {
+	// a1 is smaller than b1, the smallest main-chain element: no comparison needed.
+	chain.insertAt(0, pend[0]);
+
+	size_t total = k + (odd ? 1 : 0);
+	size_t done = 1;
+	size_t previous = 1;
+	while (done < total) {
+		size_t next = done + 2 * previous;
+		previous = done;
+		chain.beginGroup(done, std::min(next, k));
+		for (size_t i = std::min(next, total); i > done; i--) {
+			uint32_t position;
+			size_t bound;
+			if (i <= k) {
+				position = pend[i - 1];
+				bound = chain.bigRank(i - 1);
+			} else {
+				position = static_cast<uint32_t>(2 * k);
+				bound = chain.size();
+			}
+			chain.insertAt(_search(handles, chain, bound, position), position);
+		}
+		done = next;
+	}
+}
+
+/**
+ * @brief Finds the lower-bound index of position among the first bound chain entries.
+ *
+ * Probes exactly like std::lower_bound, so comparison counts match it.
+ */
+template<typename RandomIt, typename Compare>
+template<typename Chain>
+size_t MergeInsertionSort<RandomIt, Compare>::_search(const uint32_t *handles, const Chain &chain, size_t bound,
+	uint32_t position) {
+	size_t lo = 0;
+	size_t len = bound;
+
+	while (len > 0) {
+		size_t half = len / 2;
+		if (_less(handles[chain.at(lo + half)], handles[position])) {
+			lo += half + 1;
+			len -= half + 1;
+		} else {
+			len = half;
+		}
+	}
+	return lo;
+}
+
+/**
+ * @brief Rearranges the input like apply_permutation, with two sequential passes.
+ *
+ * The elements are gathered into a buffer of n copies, which is the one allocation
+ * beyond the arena, then stored back. Both passes write in order and the gather reads
+ * through order, which unlike following the permutation's cycles lets the hardware
+ * prefetch every stream but the scattered reads. With a pool, each pass is split
+ * across the threads.
+ */
+template<typename RandomIt, typename Compare>
+void MergeInsertionSort<RandomIt, Compare>::_gatherPermutation(uint32_t *order) {
+	std::vector<value_type, CountingAllocator<value_type> > gathered(_n, _first[0]);
+
+	_gathered = &gathered[0];
+	_level.order = order;
+	if (_pool) {
+		MethodTask<MergeInsertionSort> gather(*this, &MergeInsertionSort::_gatherRange);
+		MethodTask<MergeInsertionSort> store(*this, &MergeInsertionSort::_storeRange);
+		_pool->parallelFor(0, _n, MERGE_INSERTION_PARALLEL_GRAIN, gather);
+		_pool->parallelFor(0, _n, MERGE_INSERTION_PARALLEL_GRAIN, store);
+	} else {
+		_gatherRange(0, _n);
+		_storeRange(0, _n);
+	}
+	_gathered = NULL;
+}
+
+template<typename RandomIt, typename Compare>
+void MergeInsertionSort<RandomIt, Compare>::_gatherRange(size_t begin, size_t end) {
+	for (size_t i = begin; i < end; i++) {
+		_gathered[i] = _first[_level.order[i]];
+	}
+}
+
+template<typename RandomIt, typename Compare>
+void MergeInsertionSort<RandomIt, Compare>::_storeRange(size_t begin, size_t end) {
+	for (size_t i = begin; i < end; i++) {
+		_first[i] = _gathered[i];
+	}
+}
+
+/**
+ * @brief Sorts [first, last) with the arena-backed Ford-Johnson engine.
+ *
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ * @param comp Strict weak ordering on the element type.
+ * @param options Insertion order, chain strategy and thread count.
+ * @return Allocation and memory figures of the sort.
+ */
+template<typename RandomIt, typename Compare>
+MergeInsertionStats merge_insertion_sort(RandomIt first, RandomIt last, Compare comp,
+	const MergeInsertionOptions &options = MergeInsertionOptions()) {
+	MergeInsertionSort<RandomIt, Compare> sorter(first, last, comp, options);
+
+	sorter.sort();
+	return sorter.stats();
+}
+
+/**
+ * @brief Computes the sorted order of [first, last) without moving the elements.
+ *
+ * Meant for large records with a costly comparator: the engine sorts 32-bit handles, so
+ * the payloads are only read by comp, and it makes close to the minimum number of
+ * comparisons. Apply the result with apply_permutation() or by gathering
+ * first[order[i]] into new storage.
+ *
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ * @param comp Strict weak ordering on the element type.
+ * @param order Receives last - first positions in sorted order.
+ * @param options Insertion order, chain strategy and thread count.
+ * @return Allocation and memory figures of the sort.
+ */
+template<typename RandomIt, typename Compare>
+MergeInsertionStats merge_insertion_order(RandomIt first, RandomIt last, Compare comp, uint32_t *order,
+	const MergeInsertionOptions &options = MergeInsertionOptions()) {
+	MergeInsertionSort<RandomIt, Compare> sorter(first, last, comp, options);
+
+	sorter.sortOrder(order);
+	return sorter.stats();
+}
+
+#endif
@@ -0,0 +1,163 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   OutputWriter.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "OutputWriter.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+	const char DIGIT_PAIRS[] =
+		"00010203040506070809"
+		"10111213141516171819"
+		"20212223242526272829"
+		"30313233343536373839"
+		"40414243444546474849"
+		"50515253545556575859"
+		"60616263646566676869"
+		"70717273747576777879"
+		"80818283848586878889"
+		"90919293949596979899";
+}
+
+/**
+ * @brief Writes the decimal digits of value to out, which has room for 10 characters.
+ *
+ * Produces two digits per division, from the right, into a scratch buffer.
+ *
+ * @return Number of characters written.
+ */
+size_t format_number(uint32_t value, char *out) {
+	char digits[10];
+	char *p = digits + sizeof(digits);
+
+	while (value >= 100) {
+		const char *pair = DIGIT_PAIRS + value % 100 * 2;
+		value /= 100;
+		*--p = pair[1];
+		*--p = pair[0];
+	}
+	if (value >= 10) {
+		*--p = DIGIT_PAIRS[value * 2 + 1];
+		*--p = DIGIT_PAIRS[value * 2];
+	} else {
+		*--p = static_cast<char>('0' + value);
+	}
+
+	size_t length = digits + sizeof(digits) - p;
+	std::memcpy(out, p, length);
+	return length;
+}
+
+/**
+ * @brief Writes to fd, which stays owned by the caller.
+ * @param fd The descriptor.
+ * @param block_size Bytes collected before each write(2).
+ */
+OutputWriter::OutputWriter(int fd, size_t block_size) : _fd(fd), _buffer(block_size < 64 ? 64 : block_size), _used(0) {
+}
+
+/**
+ * @brief Flushes what is left; errors are only reported by an explicit flush().
+ */
+OutputWriter::~OutputWriter() {
+	try {
+		flush();
+	} catch (const std::exception &) {
+	}
+}
+
+/**
+ * @brief Appends text.
+ */
+void OutputWriter::write(const std::string &text) {
+	for (size_t done = 0; done < text.size();) {
+		if (_used == _buffer.size()) {
+			flush();
+		}
+		size_t part = std::min(text.size() - done, _buffer.size() - _used);
+		std::memcpy(&_buffer[_used], text.data() + done, part);
+		_used += part;
+		done += part;
+	}
+}
+
+/**
+ * @brief Appends value in decimal followed by separator.
+ */
+void OutputWriter::writeNumber(uint32_t value, char separator) {
+	if (_buffer.size() - _used < 11) {
+		flush();
+	}
+	_used += format_number(value, &_buffer[_used]);
+	_buffer[_used++] = separator;
+}
+
+/**
+ * @brief Appends value as 4 little-endian bytes, the binary input format.
+ */
+void OutputWriter::writeBinary(uint32_t value) {
+	if (_buffer.size() - _used < 4) {
+		flush();
+	}
+	char *p = &_buffer[_used];
+	p[0] = static_cast<char>(value);
+	p[1] = static_cast<char>(value >> 8);
+	p[2] = static_cast<char>(value >> 16);
+	p[3] = static_cast<char>(value >> 24);
+	_used += 4;
+}
+
+/**
+ * @brief Writes out the buffered bytes.
+ * @throws std::runtime_error If the write fails.
+ */
+void OutputWriter::flush() {
+	size_t done = 0;
+
+	while (done < _used) {
+		ssize_t written = ::write(_fd, &_buffer[done], _used - done);
+		if (written < 0 && errno == EINTR) {
+			continue;
+		}
+		if (written < 0) {
+			_used = 0;
+			throw std::runtime_error(std::string("Cannot write output: ") + std::strerror(errno));
+		}
+		done += written;
+	}
+	_used = 0;
+}
+
+/**
+ * @brief Opens path for writing, creating or truncating it.
+ * @throws std::runtime_error If the file cannot be opened.
+ */
+OutputFile::OutputFile(const std::string &path) : _fd(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)) {
+	if (_fd < 0) {
+		throw std::runtime_error("Cannot open " + path + ": " + std::strerror(errno));
+	}
+}
+
+/**
+ * @brief Closes the file.
+ */
+OutputFile::~OutputFile() {
+	::close(_fd);
+}
+
+int OutputFile::fd() const {
+	return _fd;
+}
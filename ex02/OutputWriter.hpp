@@ -0,0 +1,126 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   OutputWriter.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef OUTPUTWRITER_HPP
+#define OUTPUTWRITER_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/**
+ * @brief Bytes an OutputWriter collects before each write(2).
+ */
+const size_t OUTPUT_BLOCK_SIZE = 1 << 20;
+
+/**
+ * @brief Writes the decimal digits of value to out, which has room for 10 characters.
+ * @return Number of characters written.
+ */
+size_t format_number(uint32_t value, char *out);
+
+/**
+ * @class OutputWriter
+ * @brief Formats numbers into a large block buffer and hands it to write(2) when full.
+ *
+ * Bypasses iostreams, so anything already sent to std::cout must be flushed before the
+ * first write, and this writer flushed before std::cout is used again.
+ */
+class OutputWriter {
+	public:
+		/**
+		 * @brief Writes to fd, which stays owned by the caller.
+		 */
+		explicit OutputWriter(int fd, size_t block_size = OUTPUT_BLOCK_SIZE);
+
+		/**
+		 * @brief Flushes what is left; errors are only reported by an explicit flush().
+		 */
+		~OutputWriter();
+
+		/**
+		 * @brief Appends text.
+		 */
+		void write(const std::string &text);
+
+		/**
+		 * @brief Appends value in decimal followed by separator.
+		 */
+		void writeNumber(uint32_t value, char separator);
+
+		/**
+		 * @brief Appends value as 4 little-endian bytes, the binary input format.
+		 */
+		void writeBinary(uint32_t value);
+
+		/**
+		 * @brief Writes out the buffered bytes.
+		 * @throws std::runtime_error If the write fails.
+		 */
+		void flush();
+
+	private:
+		int _fd;
+		std::vector<char> _buffer;
+		size_t _used;
+
+		OutputWriter(const OutputWriter &other);
+
+		OutputWriter &operator=(const OutputWriter &other);
+};
+
+/**
+ * @brief Writes [first, last) as text, each number followed by a space, like the
+ * "Before:" and "After:" lines have always been printed.
+ */
+template<typename InputIt>
+void write_numbers(OutputWriter &out, InputIt first, InputIt last) {
+	for (; first != last; ++first) {
+		out.writeNumber(*first, ' ');
+	}
+}
+
+/**
+ * @brief Writes [first, last) as little-endian 32-bit values.
+ */
+template<typename InputIt>
+void write_binary(OutputWriter &out, InputIt first, InputIt last) {
+	for (; first != last; ++first) {
+		out.writeBinary(*first);
+	}
+}
+
+/**
+ * @class OutputFile
+ * @brief A file opened for writing, created or truncated, and closed on destruction.
+ */
+class OutputFile {
+	public:
+		/**
+		 * @throws std::runtime_error If the file cannot be opened.
+		 */
+		explicit OutputFile(const std::string &path);
+
+		~OutputFile();
+
+		int fd() const;
+
+	private:
+		int _fd;
+
+		OutputFile(const OutputFile &other);
+
+		OutputFile &operator=(const OutputFile &other);
+};
+
+#endif
@@ -11,6 +11,8 @@
 /* ************************************************************************** */
 
 #include "PmergeMe.hpp"
+#include <cmath>
+#include <cstring>
 
 /**
  * @brief Converts a string to an unsigned 32-bit integer (uint32_t).
@@ -19,6 +21,7 @@
  * It performs error checking to ensure the input string only contains numeric characters
  * and that the converted value is within the range of uint32_t. If the string contains invalid characters
  * or the value exceeds the range of uint32_t, it throws an appropriate exception.
+ * The number itself is read by parse_number, which accepts exactly what strtol did here.
  *
  * @param str A C-style string to be converted to an unsigned integer.
  * @return The converted unsigned integer (uint32_t).
@@ -26,240 +29,105 @@
  * @throws std::overflow_error If the number exceeds the range of uint32_t.
  */
 uint32_t str_to_uint(const char *str) {
-	// Pointer to the first invalid character in the input string.
-	char *endptr;
-
-	// Reset errno before calling strtol.
-	errno = 0;
-
-	// Convert the input string to a long integer.
-	long num = std::strtol(str, &endptr, 10);
+	// strtol read an empty argument as 0; keep accepting it.
+	if (*str == '\0') {
+		return 0;
+	}
 
-	// Check for conversion errors : non-numeric characters, overflow, or underflow.
-	if (*endptr != '\0' || errno != 0 || num < 0 || num > UINT32_MAX) {
+	// Leading separators are skipped, trailing ones are not.
+	const char *p = str;
+	while (is_number_space(*p)) {
+		p++;
+	}
+	if (*p == '\0') {
 		throw std::invalid_argument("Invalid input number");
 	}
 
-	// Return the converted value as an unsigned integer.
-	return static_cast<uint32_t>(num);
+	const char *end = p + std::strlen(p);
+	uint32_t value;
+	if (parse_number(p, end, value) != end) {
+		throw std::invalid_argument("Invalid input number");
+	}
+	return value;
 }
 
 
 /**
- * @brief Generates an Jacobstal sequence for insertion.
+ * @brief Writes the pend insertion order for [left, right] into out and advances it.
  *
- * This function generates a Jacobstal insertion sequence for the Ford-Johnson algorithm.
+ * Same order as generate_insertion_sequence, but into a caller-provided buffer.
  *
  * @param left The left index of the sequence.
  * @param right The right index of the sequence.
- * @param sequence The vector to store the generated sequence.
+ * @param out Destination cursor, advanced past the written indices.
  */
-void generate_insertion_sequence(size_t left, size_t right, std::vector <size_t> &sequence) {
+void fill_insertion_sequence(size_t left, size_t right, uint32_t *&out) {
 	if (left > right) return;
 	size_t mid = left + (right - left) / 2;
-	sequence.push_back(mid);
+	*out++ = static_cast<uint32_t>(mid);
 	if (mid > 0) {
-		generate_insertion_sequence(left, mid - 1, sequence);
+		fill_insertion_sequence(left, mid - 1, out);
 	}
-	generate_insertion_sequence(mid + 1, right, sequence);
+	fill_insertion_sequence(mid + 1, right, out);
 }
 
 /**
- * @brief Implements the Ford-Johnson sorting algorithm (Merge-Insertion Sort) for std::vector.
+ * @brief Worst-case comparison count of Ford-Johnson, F(n) = sum of ceil(log2(3k/4)).
  *
- * This function sorts a vector of unsigned integers using the Ford-Johnson algorithm.
- * The algorithm pairs consecutive elements, sorts those pairs, and merges them back into
- * a final sorted sequence. It uses binary insertion to maintain the sorted order.
+ * ceil(log2(3k/4)) is the smallest c with 2^(c+2) >= 3k.
  *
- * @param arr The vector of unsigned integers to be sorted.
+ * @param n Number of elements.
+ * @return F(n).
  */
-void ford_johnson(std::vector <uint32_t> &arr) {
-
-	// Base case: If the vector has 0 or 1 elements, it is already sorted.
-	if (arr.size() <= 1) {
-		return;
-	}
-
-	// Special case: If the vector has up to 16 elements, use insertion sort.
-	if (arr.size() <= 16) {
-
-		// insertion sort
-		for (size_t i = 1; i < arr.size(); i++) {
-			uint32_t key = arr[i];
-			size_t j = i;
-			while (j > 0 && arr[j - 1] > key) {
-				arr[j] = arr[j - 1];
-				j--;
-			}
-			arr[j] = key;
-		}
-		return;
-	}
-
-	// Holds the last unpaired element if the vector has an odd size.
-	std::vector <uint32_t> straggler;
-
-	// Check if the vector has an odd size.
-	if (arr.size() % 2) {
-		straggler.push_back(arr.back());
-		arr.pop_back();
-	}
+unsigned long ford_johnson_bound(size_t n) {
+	unsigned long total = 0;
+	unsigned long c = 0;
 
-	// Pair consecutive elements and store them in a vector of pairs.
-	std::vector <std::pair<uint32_t, uint32_t> > pairs;
-
-	// Pair consecutive elements and sort.
-	for (size_t i = 0; i < arr.size(); i += 2) {
-		if (arr[i] < arr[i + 1]) {
-			pairs.push_back(std::make_pair(arr[i + 1], arr[i]));
-		} else {
-			pairs.push_back(std::make_pair(arr[i], arr[i + 1]));
+	for (size_t k = 1; k <= n; k++) {
+		while ((static_cast<uint64_t>(1) << (c + 2)) < 3 * static_cast<uint64_t>(k)) {
+			c++;
 		}
+		total += c;
 	}
+	return total;
+}
 
-	// Separate pairs into two sequences:
-	// 1. S (first elements of each pair)
-	std::vector <uint32_t> S;
-
-	for (size_t i = 0; i < pairs.size(); i++) {
-		S.push_back(pairs[i].first);
-	}
-
-	// Sort S using Ford-Johnson algorithm.
-	ford_johnson(S);
-
-	// 2. pend (second elements of each pair)
-	std::vector <uint32_t> pend;
-
-	for (size_t i = 0; i < pairs.size(); i++) {
-		pend.push_back(pairs[i].second);
-	}
-
-	// Insert pend[0] to S
-	std::vector<uint32_t>::iterator it = std::lower_bound(S.begin(), S.end(), pend[0]);
-	S.insert(it, pend[0]);
-
-	// Generate insertion sequence for the pend vector.
-	std::vector <size_t> insertion_sequence;
-	generate_insertion_sequence(1, pend.size() - 1, insertion_sequence);
-
-	// Insert remaining elements of pend into S using insertion sequence.
-	for (size_t i = 0; i < insertion_sequence.size(); i++) {
-		size_t idx = insertion_sequence[i];
-		if (idx < pend.size()) {
-			uint32_t value_to_insert = pend[idx];
-
-			it = std::lower_bound(S.begin(), S.end(), value_to_insert);
-			S.insert(it, value_to_insert);
-		}
-	}
+/**
+ * @brief Information-theoretic lower bound on comparisons, ceil(log2(n!)).
+ *
+ * @param n Number of elements.
+ * @return ceil(log2(n!)).
+ */
+unsigned long comparison_lower_bound(size_t n) {
+	double bits = 0;
 
-	// If there was a straggler, insert it into S in sorted order.
-	if (!straggler.empty()) {
-		it = std::lower_bound(S.begin(), S.end(), straggler[0]);
-		S.insert(it, straggler[0]);
+	for (size_t k = 2; k <= n; k++) {
+		bits += std::log(static_cast<double>(k));
 	}
+	return static_cast<unsigned long>(std::ceil(bits / std::log(2.0) - 1e-9));
+}
 
-	// Copy the sorted result back into the original vector.
-	arr = S;
+/**
+ * @brief Implements the Ford-Johnson sorting algorithm (Merge-Insertion Sort) for std::vector.
+ *
+ * This function sorts a vector of unsigned integers with the templated Ford-Johnson engine.
+ * The main chain is kept in contiguous memory.
+ *
+ * @param arr The vector of unsigned integers to be sorted.
+ */
+void ford_johnson(std::vector <uint32_t> &arr) {
+	ford_johnson(arr, std::less<uint32_t>());
 }
 
 /**
  * @brief Implements the Ford-Johnson sorting algorithm (Merge-Insertion Sort) for std::deque.
  *
- * This function sorts a deque of unsigned integers using the Ford-Johnson algorithm.
- * The algorithm pairs consecutive elements, sorts those pairs, and merges them back into
- * a final sorted sequence. It uses binary insertion to maintain the sorted order.
+ * This function sorts a deque of unsigned integers with the templated Ford-Johnson engine.
+ * The main chain is a TieredVector, whose circular chunks make a mid-chain insertion
+ * move O(sqrt(n)) elements instead of the O(n) a std::deque would shift.
  *
  * @param arr The deque of unsigned integers to be sorted.
  */
 void ford_johnson(std::deque <uint32_t> &arr) {
-
-	// Base case: If the deque has 0 or 1 elements, it is already sorted.
-	if (arr.size() <= 1) {
-		return;
-	}
-
-	// Special case: If the deque has up to 16 elements, use insertion sort.
-	if (arr.size() <= 16) {
-
-		// insertion sort
-		for (size_t i = 1; i < arr.size(); i++) {
-			uint32_t key = arr[i];
-			size_t j = i;
-			while (j > 0 && arr[j - 1] > key) {
-				arr[j] = arr[j - 1];
-				j--;
-			}
-			arr[j] = key;
-		}
-		return;
-	}
-
-	// Holds the last unpaired element if the deque has an odd size.
-	std::deque <uint32_t> straggler;
-
-	// Check if the deque has an odd size.
-	if (arr.size() % 2) {
-		straggler.push_back(arr.back());
-		arr.pop_back();
-	}
-
-	// Pair consecutive elements and store them in a deque of pairs.
-	std::deque <std::pair<uint32_t, uint32_t> > pairs;
-
-	// Pair consecutive elements and sort.
-	for (size_t i = 0; i < arr.size(); i += 2) {
-		if (arr[i] < arr[i + 1]) {
-			pairs.push_back(std::make_pair(arr[i + 1], arr[i]));
-		} else {
-			pairs.push_back(std::make_pair(arr[i], arr[i + 1]));
-		}
-	}
-
-	// Separate pairs into two sequences:
-	// 1. S (first elements of each pair)
-	std::deque <uint32_t> S;
-
-	for (size_t i = 0; i < pairs.size(); i++) {
-		S.push_back(pairs[i].first);
-	}
-
-	// Sort the S sequence using Ford-Johnson.
-	ford_johnson(S);
-
-	// 2. pend (second elements of each pair)
-	std::deque <uint32_t> pend;
-
-	for (size_t i = 0; i < pairs.size(); i++) {
-		pend.push_back(pairs[i].second);
-	}
-
-	// Insert pend[0] to S
-	std::deque<uint32_t>::iterator it = std::lower_bound(S.begin(), S.end(), pend[0]);
-	S.insert(it, pend[0]);
-
-	// Generate insertion sequence for the pend vector.
-	std::vector <size_t> insertion_sequence;
-	generate_insertion_sequence(1, pend.size() - 1, insertion_sequence);
-
-	// Insert remaining elements of pend into S using insertion sequence.
-	for (size_t i = 0; i < insertion_sequence.size(); i++) {
-		size_t idx = insertion_sequence[i];
-		if (idx < pend.size()) {
-			uint32_t value_to_insert = pend[idx];
-
-			it = std::lower_bound(S.begin(), S.end(), value_to_insert);
-			S.insert(it, value_to_insert);
-		}
-	}
-
-	// If there was a straggler, insert it into S in sorted order.
-	if (!straggler.empty()) {
-		it = std::lower_bound(S.begin(), S.end(), straggler[0]);
-		S.insert(it, straggler[0]);
-	}
-
-	// Copy the sorted result back into the original deque.
-	arr = S;
+	ford_johnson(arr, std::less<uint32_t>());
 }
@@ -20,6 +20,11 @@
 #include <cerrno>
 #include <climits>
 #include <limits.h>
+#include <stdint.h>
+#include <cstdlib>
+#include "FordJohnson.hpp"
+#include "InputReader.hpp"
+#include "MergeInsertion.hpp"
 
 /**
  * @brief Converts a string to an unsigned 32-bit integer (uint32_t).
@@ -41,6 +46,7 @@ uint32_t str_to_uint(const char* str);
  * @brief Implements the Ford-Johnson sorting algorithm (Merge-Insertion Sort) for std::vector.
  *
  * This function sorts a std::vector of unsigned integers using the Ford-Johnson algorithm.
+ * Other containers, element types and comparators can use the templates in FordJohnson.hpp.
  *
  * @param arr The std::vector of unsigned integers to be sorted.
  */
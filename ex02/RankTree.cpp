@@ -0,0 +1,206 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RankTree.cpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "RankTree.hpp"
+
+const uint32_t RankTree::NIL;
+
+/**
+ * @brief Takes the node arrays for capacity ids from the arena.
+ * @param arena Arena providing words(capacity) words.
+ * @param capacity Ids stored must be below this value.
+ */
+RankTree::RankTree(SortArena &arena, size_t capacity)
+	: _nodes(arena.allocate(words(capacity))), _root(NIL) {
+}
+
+/**
+ * @brief Arena words needed for a tree of the given capacity.
+ */
+size_t RankTree::words(size_t capacity) {
+	return FIELDS * capacity;
+}
+
+/**
+ * @brief Number of ids in the sequence.
+ */
+size_t RankTree::size() const {
+	return _subtree(_root);
+}
+
+/**
+ * @brief Inserts id so that it ends up at the given rank.
+ *
+ * Descends by subtree sizes to the leaf slot for the rank, then rotates the new node up
+ * until the heap order on priorities holds again.
+ *
+ * @param rank Target rank, at most size().
+ * @param id An id not yet in the tree.
+ */
+void RankTree::insertAt(size_t rank, uint32_t id) {
+	_field(id, LEFT) = NIL;
+	_field(id, RIGHT) = NIL;
+	_field(id, COUNT) = 1;
+
+	if (_root == NIL) {
+		_field(id, PARENT) = NIL;
+		_root = id;
+		return;
+	}
+
+	uint32_t node = _root;
+	while (true) {
+		_field(node, COUNT)++;
+		size_t left = _subtree(_field(node, LEFT));
+		if (rank <= left) {
+			if (_field(node, LEFT) == NIL) {
+				_field(node, LEFT) = id;
+				break;
+			}
+			node = _field(node, LEFT);
+		} else {
+			rank -= left + 1;
+			if (_field(node, RIGHT) == NIL) {
+				_field(node, RIGHT) = id;
+				break;
+			}
+			node = _field(node, RIGHT);
+		}
+	}
+	_field(id, PARENT) = node;
+
+	while (_field(id, PARENT) != NIL && _priority(id) > _priority(_field(id, PARENT))) {
+		_rotateUp(id);
+	}
+}
+
+/**
+ * @brief Returns the id at the given rank.
+ */
+uint32_t RankTree::at(size_t rank) const {
+	uint32_t node = _root;
+
+	while (true) {
+		size_t left = _subtree(_field(node, LEFT));
+		if (rank < left) {
+			node = _field(node, LEFT);
+		} else if (rank == left) {
+			return node;
+		} else {
+			rank -= left + 1;
+			node = _field(node, RIGHT);
+		}
+	}
+}
+
+/**
+ * @brief Returns the current rank of an id in the tree.
+ */
+size_t RankTree::rank(uint32_t id) const {
+	size_t result = _subtree(_field(id, LEFT));
+
+	for (uint32_t node = id; _field(node, PARENT) != NIL; node = _field(node, PARENT)) {
+		if (_field(_field(node, PARENT), RIGHT) == node) {
+			result += _subtree(_field(_field(node, PARENT), LEFT)) + 1;
+		}
+	}
+	return result;
+}
+
+/**
+ * @brief Writes the ids in sequence order.
+ *
+ * In-order walk that follows parent links instead of keeping a stack.
+ *
+ * @param out Destination of size() ids.
+ */
+void RankTree::flatten(uint32_t *out) const {
+	uint32_t node = _root;
+
+	while (node != NIL && _field(node, LEFT) != NIL) {
+		node = _field(node, LEFT);
+	}
+	while (node != NIL) {
+		*out++ = node;
+		if (_field(node, RIGHT) != NIL) {
+			node = _field(node, RIGHT);
+			while (_field(node, LEFT) != NIL) {
+				node = _field(node, LEFT);
+			}
+		} else {
+			while (_field(node, PARENT) != NIL && _field(_field(node, PARENT), RIGHT) == node) {
+				node = _field(node, PARENT);
+			}
+			node = _field(node, PARENT);
+		}
+	}
+}
+
+uint32_t &RankTree::_field(uint32_t node, Field field) {
+	return _nodes[static_cast<size_t>(node) * FIELDS + field];
+}
+
+uint32_t RankTree::_field(uint32_t node, Field field) const {
+	return _nodes[static_cast<size_t>(node) * FIELDS + field];
+}
+
+uint32_t RankTree::_subtree(uint32_t node) const {
+	return node == NIL ? 0 : _field(node, COUNT);
+}
+
+/**
+ * @brief Hashes an id into a pseudo-random priority (murmur3 finalizer).
+ */
+uint32_t RankTree::_priority(uint32_t id) {
+	uint32_t h = id + 0x9E3779B9u;
+	h ^= h >> 16;
+	h *= 0x85EBCA6Bu;
+	h ^= h >> 13;
+	h *= 0xC2B2AE35u;
+	h ^= h >> 16;
+	return h;
+}
+
+/**
+ * @brief Rotates node above its parent, keeping the sequence order and subtree sizes.
+ */
+void RankTree::_rotateUp(uint32_t node) {
+	uint32_t parent = _field(node, PARENT);
+	uint32_t grandparent = _field(parent, PARENT);
+
+	if (_field(parent, LEFT) == node) {
+		_field(parent, LEFT) = _field(node, RIGHT);
+		if (_field(node, RIGHT) != NIL) {
+			_field(_field(node, RIGHT), PARENT) = parent;
+		}
+		_field(node, RIGHT) = parent;
+	} else {
+		_field(parent, RIGHT) = _field(node, LEFT);
+		if (_field(node, LEFT) != NIL) {
+			_field(_field(node, LEFT), PARENT) = parent;
+		}
+		_field(node, LEFT) = parent;
+	}
+	_field(parent, PARENT) = node;
+	_field(node, PARENT) = grandparent;
+
+	if (grandparent == NIL) {
+		_root = node;
+	} else if (_field(grandparent, LEFT) == parent) {
+		_field(grandparent, LEFT) = node;
+	} else {
+		_field(grandparent, RIGHT) = node;
+	}
+
+	_field(parent, COUNT) = 1 + _subtree(_field(parent, LEFT)) + _subtree(_field(parent, RIGHT));
+	_field(node, COUNT) = 1 + _subtree(_field(node, LEFT)) + _subtree(_field(node, RIGHT));
+}
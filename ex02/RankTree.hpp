@@ -0,0 +1,98 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RankTree.hpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef RANKTREE_HPP
+#define RANKTREE_HPP
+
+#include <cstddef>
+#include <stdint.h>
+#include "SortArena.hpp"
+
+/**
+ * @class RankTree
+ * @brief Order-statistic treap over node ids, addressed by rank.
+ *
+ * Stores a sequence of distinct ids in [0, capacity) and supports insertion at a rank,
+ * lookup by rank and the rank of an id, all in expected O(log n), without moving the
+ * other entries. Priorities are a hash of the id, so the shape is deterministic. The
+ * four fields of a node are stored next to each other so a descent touches one cache
+ * line per level.
+ * The node arrays are slices of a SortArena; RankTree::words() tells how much to reserve.
+ */
+class RankTree {
+	public:
+		/**
+		 * @brief Takes the node arrays for capacity ids from the arena.
+		 * @param arena Arena providing words(capacity) words.
+		 * @param capacity Ids stored must be below this value.
+		 */
+		RankTree(SortArena &arena, size_t capacity);
+
+		/**
+		 * @brief Arena words needed for a tree of the given capacity.
+		 */
+		static size_t words(size_t capacity);
+
+		/**
+		 * @brief Number of ids in the sequence.
+		 */
+		size_t size() const;
+
+		/**
+		 * @brief Inserts id so that it ends up at the given rank.
+		 * @param rank Target rank, at most size().
+		 * @param id An id not yet in the tree.
+		 */
+		void insertAt(size_t rank, uint32_t id);
+
+		/**
+		 * @brief Returns the id at the given rank.
+		 */
+		uint32_t at(size_t rank) const;
+
+		/**
+		 * @brief Returns the current rank of an id in the tree.
+		 */
+		size_t rank(uint32_t id) const;
+
+		/**
+		 * @brief Writes the ids in sequence order.
+		 * @param out Destination of size() ids.
+		 */
+		void flatten(uint32_t *out) const;
+
+	private:
+		static const uint32_t NIL = UINT32_MAX;
+
+		enum Field {
+			LEFT,
+			RIGHT,
+			PARENT,
+			COUNT,
+			FIELDS
+		};
+
+		uint32_t *_nodes;
+		uint32_t _root;
+
+		uint32_t &_field(uint32_t node, Field field);
+
+		uint32_t _field(uint32_t node, Field field) const;
+
+		uint32_t _subtree(uint32_t node) const;
+
+		static uint32_t _priority(uint32_t id);
+
+		void _rotateUp(uint32_t node);
+};
+
+#endif
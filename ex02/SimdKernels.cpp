@@ -0,0 +1,280 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   SimdKernels.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "SimdKernels.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+# define SIMD_KERNELS_X86 1
+# include <immintrin.h>
+#else
+# define SIMD_KERNELS_X86 0
+#endif
+
+namespace {
+
+	void split_pairs_scalar(const uint32_t *in, size_t begin, size_t pairs, uint32_t *big, uint32_t *small) {
+		for (size_t i = begin; i < pairs; i++) {
+			uint32_t a = in[2 * i];
+			uint32_t b = in[2 * i + 1];
+			big[i] = std::max(a, b);
+			small[i] = std::min(a, b);
+		}
+	}
+
+	void sort_small_scalar(uint32_t *data, size_t n) {
+		for (size_t i = 1; i < n; i++) {
+			uint32_t key = data[i];
+			size_t j = i;
+			while (j > 0 && key < data[j - 1]) {
+				data[j] = data[j - 1];
+				j--;
+			}
+			data[j] = key;
+		}
+	}
+
+#if SIMD_KERNELS_X86
+	/**
+	 * @brief Four pairs per step: de-interleave two registers, then min/max.
+	 */
+	__attribute__((target("sse4.1")))
+	void split_pairs_sse41(const uint32_t *in, size_t pairs, uint32_t *big, uint32_t *small) {
+		size_t i = 0;
+
+		for (; i + 4 <= pairs; i += 4) {
+			__m128 lo = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 2 * i)));
+			__m128 hi = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 2 * i + 4)));
+			__m128i first = _mm_castps_si128(_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+			__m128i second = _mm_castps_si128(_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(big + i), _mm_max_epu32(first, second));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(small + i), _mm_min_epu32(first, second));
+		}
+		split_pairs_scalar(in, i, pairs, big, small);
+	}
+
+	/**
+	 * @brief Eight pairs per step; the in-lane shuffle leaves 64-bit blocks out of order.
+	 */
+	__attribute__((target("avx2")))
+	void split_pairs_avx2(const uint32_t *in, size_t pairs, uint32_t *big, uint32_t *small) {
+		size_t i = 0;
+
+		for (; i + 8 <= pairs; i += 8) {
+			__m256 lo = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + 2 * i)));
+			__m256 hi = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + 2 * i + 8)));
+			__m256i first = _mm256_castps_si256(_mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+			__m256i second = _mm256_castps_si256(_mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)));
+			first = _mm256_permute4x64_epi64(first, _MM_SHUFFLE(3, 1, 2, 0));
+			second = _mm256_permute4x64_epi64(second, _MM_SHUFFLE(3, 1, 2, 0));
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(big + i), _mm256_max_epu32(first, second));
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(small + i), _mm256_min_epu32(first, second));
+		}
+		split_pairs_scalar(in, i, pairs, big, small);
+	}
+
+	/**
+	 * @brief One compare-exchange step of distance j < 8 inside a register of 8 lanes.
+	 *
+	 * Lane p of the register holding elements base..base+7 keeps the larger value when
+	 * it is the upper partner of an ascending block or the lower one of a descending block.
+	 */
+	__attribute__((target("avx2")))
+	inline __m256i bitonic_step(__m256i x, int j, int k, int base) {
+		int lanes[8];
+		int takes_max[8];
+		for (int p = 0; p < 8; p++) {
+			lanes[p] = p ^ j;
+			takes_max[p] = ((p & j) != 0) != (((base + p) & k) != 0) ? -1 : 0;
+		}
+
+		__m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes));
+		__m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(takes_max));
+		__m256i partner = _mm256_permutevar8x32_epi32(x, index);
+		return _mm256_blendv_epi8(_mm256_min_epu32(x, partner), _mm256_max_epu32(x, partner), mask);
+	}
+
+	/**
+	 * @brief Bitonic sort of 16 values held in two registers, padded with UINT32_MAX.
+	 */
+	__attribute__((target("avx2")))
+	void sort_small_avx2(uint32_t *data, size_t n) {
+		uint32_t block[SIMD_SMALL_SORT_MAX];
+		std::fill(std::copy(data, data + n, block), block + SIMD_SMALL_SORT_MAX, UINT32_MAX);
+
+		__m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+		__m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 8));
+		for (int k = 2; k <= 16; k *= 2) {
+			for (int j = k / 2; j > 0; j /= 2) {
+				if (j == 8) {
+					__m256i smaller = _mm256_min_epu32(low, high);
+					high = _mm256_max_epu32(low, high);
+					low = smaller;
+				} else {
+					low = bitonic_step(low, j, k, 0);
+					high = bitonic_step(high, j, k, 8);
+				}
+			}
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(block), low);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(block + 8), high);
+		std::copy(block, block + n, data);
+	}
+#endif
+
+	SimdLevel detect_simd_level() {
+#if SIMD_KERNELS_X86
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2")) {
+			return SIMD_AVX2;
+		}
+		if (__builtin_cpu_supports("sse4.1")) {
+			return SIMD_SSE41;
+		}
+#endif
+		return SIMD_SCALAR;
+	}
+
+	const SimdLevel supported_level = detect_simd_level();
+	SimdLevel active_level = supported_level;
+}
+
+/**
+ * @brief Best level the running CPU supports, detected once at start-up.
+ */
+SimdLevel simd_supported_level() {
+	return supported_level;
+}
+
+/**
+ * @brief Level the kernels currently use.
+ */
+SimdLevel simd_level() {
+	return active_level;
+}
+
+/**
+ * @brief Selects the level the kernels use, capped at simd_supported_level().
+ */
+void set_simd_level(SimdLevel level) {
+	active_level = std::min(level, supported_level);
+}
+
+/**
+ * @brief Printable name of a level.
+ */
+const char *simd_level_name(SimdLevel level) {
+	switch (level) {
+		case SIMD_AVX2:
+			return "avx2";
+		case SIMD_SSE41:
+			return "sse4.1";
+		default:
+			return "scalar";
+	}
+}
+
+/**
+ * @brief Parses "scalar", "sse4.1" or "avx2", or "auto" for simd_supported_level().
+ * @throws std::invalid_argument If name is none of them or the CPU lacks that level.
+ */
+SimdLevel parse_simd_level(const std::string &name) {
+	if (name == "auto") {
+		return supported_level;
+	}
+	const SimdLevel levels[] = { SIMD_SCALAR, SIMD_SSE41, SIMD_AVX2 };
+	for (size_t i = 0; i < sizeof(levels) / sizeof(levels[0]); i++) {
+		if (name != simd_level_name(levels[i])) {
+			continue;
+		}
+		if (levels[i] > supported_level) {
+			throw std::invalid_argument("This CPU does not support " + name);
+		}
+		return levels[i];
+	}
+	throw std::invalid_argument("Unknown SIMD level " + name);
+}
+
+/**
+ * @brief Checks the kernels of level against the scalar ones.
+ *
+ * The blocks mix duplicates, 0, UINT32_MAX and values with the top bit set, which a
+ * signed vector comparison would misorder. Splits cover every pair count around the
+ * vector widths and the scalar tails; small sorts cover every size up to
+ * SIMD_SMALL_SORT_MAX. The active level is restored afterwards.
+ */
+bool simd_matches_scalar(SimdLevel level) {
+	const size_t block = 64;
+	uint32_t in[2 * block];
+	uint32_t big[block], small[block], big_scalar[block], small_scalar[block];
+	uint32_t sorted[SIMD_SMALL_SORT_MAX], sorted_scalar[SIMD_SMALL_SORT_MAX];
+	uint64_t state = 0x2545f4914f6cdd1dULL;
+	SimdLevel saved = active_level;
+	bool match = true;
+
+	active_level = std::min(level, supported_level);
+	for (size_t round = 0; round < 64 && match; round++) {
+		for (size_t i = 0; i < 2 * block; i++) {
+			state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+			uint32_t random = static_cast<uint32_t>(state >> 32);
+			const uint32_t edges[] = { 0, 1, UINT32_MAX, 0x80000000u, random, random, random % 4, random | 0x80000000u };
+			in[i] = edges[(random >> 3) % 8];
+		}
+		for (size_t pairs = 0; pairs <= block && match; pairs++) {
+			split_pairs_u32(in, pairs, big, small);
+			split_pairs_scalar(in, 0, pairs, big_scalar, small_scalar);
+			match = std::equal(big, big + pairs, big_scalar) && std::equal(small, small + pairs, small_scalar);
+		}
+		for (size_t n = 0; n <= SIMD_SMALL_SORT_MAX && match; n++) {
+			std::copy(in, in + n, sorted);
+			std::copy(in, in + n, sorted_scalar);
+			sort_small_u32(sorted, n);
+			sort_small_scalar(sorted_scalar, n);
+			match = std::equal(sorted, sorted + n, sorted_scalar);
+		}
+	}
+	active_level = saved;
+	return match;
+}
+
+/**
+ * @brief Splits pairs in one pass: big[i] = max and small[i] = min of in[2i], in[2i + 1].
+ */
+void split_pairs_u32(const uint32_t *in, size_t pairs, uint32_t *big, uint32_t *small) {
+#if SIMD_KERNELS_X86
+	if (active_level == SIMD_AVX2) {
+		split_pairs_avx2(in, pairs, big, small);
+		return;
+	}
+	if (active_level == SIMD_SSE41) {
+		split_pairs_sse41(in, pairs, big, small);
+		return;
+	}
+#endif
+	split_pairs_scalar(in, 0, pairs, big, small);
+}
+
+/**
+ * @brief Sorts up to SIMD_SMALL_SORT_MAX values in place with a bitonic network.
+ *
+ * Without AVX2 the values are insertion-sorted, which gives the same result.
+ */
+void sort_small_u32(uint32_t *data, size_t n) {
+#if SIMD_KERNELS_X86
+	if (active_level == SIMD_AVX2 && n > 1) {
+		sort_small_avx2(data, n);
+		return;
+	}
+#endif
+	sort_small_scalar(data, n);
+}
@@ -0,0 +1,87 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   SimdKernels.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef SIMDKERNELS_HPP
+#define SIMDKERNELS_HPP
+
+#include <cstddef>
+#include <string>
+#include <stdint.h>
+
+/**
+ * @brief Instruction sets the uint32_t kernels can use, from slowest to fastest.
+ */
+enum SimdLevel {
+	SIMD_SCALAR,
+	SIMD_SSE41,
+	SIMD_AVX2
+};
+
+/**
+ * @brief Largest block sort_small_u32 accepts.
+ */
+const size_t SIMD_SMALL_SORT_MAX = 16;
+
+/**
+ * @brief Best level the running CPU supports, detected once at start-up.
+ */
+SimdLevel simd_supported_level();
+
+/**
+ * @brief Level the kernels currently use.
+ */
+SimdLevel simd_level();
+
+/**
+ * @brief Selects the level the kernels use, capped at simd_supported_level().
+ */
+void set_simd_level(SimdLevel level);
+
+/**
+ * @brief Printable name of a level, as accepted by parse_simd_level().
+ */
+const char *simd_level_name(SimdLevel level);
+
+/**
+ * @brief Parses "scalar", "sse4.1" or "avx2", or "auto" for simd_supported_level().
+ * @throws std::invalid_argument If name is none of them or the CPU lacks that level.
+ */
+SimdLevel parse_simd_level(const std::string &name);
+
+/**
+ * @brief Checks the kernels of level against the scalar ones on edge-case blocks of
+ * every size a kernel handles specially.
+ *
+ * @param level The level to check; must be supported.
+ * @return Whether every output matched.
+ */
+bool simd_matches_scalar(SimdLevel level);
+
+/**
+ * @brief Splits pairs in one pass: big[i] = max and small[i] = min of in[2i], in[2i + 1].
+ *
+ * @param in The 2 * pairs input values.
+ * @param pairs Number of pairs.
+ * @param big Receives the larger value of every pair.
+ * @param small Receives the smaller value of every pair.
+ */
+void split_pairs_u32(const uint32_t *in, size_t pairs, uint32_t *big, uint32_t *small);
+
+/**
+ * @brief Sorts up to SIMD_SMALL_SORT_MAX values in place with a bitonic network.
+ *
+ * @param data The values.
+ * @param n Number of values, at most SIMD_SMALL_SORT_MAX.
+ */
+void sort_small_u32(uint32_t *data, size_t n);
+
+#endif
@@ -0,0 +1,112 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   SortArena.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "SortArena.hpp"
+#include "CountingAllocator.hpp"
+#include <new>
+#include <stdexcept>
+#include <sys/mman.h>
+
+/**
+ * @brief Allocates the backing block and reports it to the allocation figures.
+ * @param words Capacity in 32-bit words.
+ * @throws std::bad_alloc If the block cannot be mapped.
+ */
+SortArena::SortArena(size_t words) : _base(NULL), _capacity(words), _top(0), _peak(0), _mapped(false) {
+	if (capacityBytes() >= SORT_ARENA_MAP_BYTES) {
+		void *block = mmap(NULL, capacityBytes(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+		if (block == MAP_FAILED) {
+			throw std::bad_alloc();
+		}
+		_base = static_cast<uint32_t *>(block);
+		_mapped = true;
+	} else {
+		_base = new uint32_t[words ? words : 1];
+	}
+	record_allocation(capacityBytes());
+}
+
+/**
+ * @brief Releases the backing block.
+ */
+SortArena::~SortArena() {
+	record_deallocation(capacityBytes());
+	if (_mapped) {
+		munmap(_base, capacityBytes());
+	} else {
+		delete[] _base;
+	}
+}
+
+/**
+ * @brief Takes a slice of words 32-bit words from the top of the arena.
+ * @param words Size of the slice.
+ * @return Pointer to the slice.
+ * @throws std::length_error if the arena is exhausted.
+ */
+uint32_t *SortArena::allocate(size_t words) {
+	if (words > _capacity - _top) {
+		throw std::length_error("SortArena: arena exhausted");
+	}
+
+	uint32_t *slice = _base + _top;
+	_top += words;
+	if (_top > _peak) {
+		_peak = _top;
+	}
+	return slice;
+}
+
+/**
+ * @brief Takes a slice of count 64-bit words, aligned to 8 bytes.
+ * @param count Size of the slice.
+ * @return Pointer to the slice.
+ * @throws std::length_error if the arena is exhausted.
+ *
+ * The backing block comes from new[] or mmap, both aligned for any scalar type, so
+ * padding the top to an even word is enough. The padding word is wasted until release().
+ */
+uint64_t *SortArena::allocateWide(size_t count) {
+	if (_top % 2) {
+		allocate(1);
+	}
+	return reinterpret_cast<uint64_t *>(allocate(2 * count));
+}
+
+/**
+ * @brief Returns the current top of the arena, to be passed to release().
+ */
+size_t SortArena::mark() const {
+	return _top;
+}
+
+/**
+ * @brief Frees every slice allocated after mark was taken.
+ * @param mark A value previously returned by mark().
+ */
+void SortArena::release(size_t mark) {
+	_top = mark;
+}
+
+/**
+ * @brief Capacity of the arena in bytes.
+ */
+size_t SortArena::capacityBytes() const {
+	return _capacity * sizeof(uint32_t);
+}
+
+/**
+ * @brief Highest number of bytes in use at any point so far.
+ */
+size_t SortArena::peakBytes() const {
+	return _peak * sizeof(uint32_t);
+}
@@ -0,0 +1,98 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   SortArena.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef SORTARENA_HPP
+#define SORTARENA_HPP
+
+#include <cstddef>
+#include <stdint.h>
+
+/**
+ * @brief Block size from which SortArena maps its memory straight from the system.
+ */
+const size_t SORT_ARENA_MAP_BYTES = 128 << 10;
+
+/**
+ * @class SortArena
+ * @brief Fixed-size bump allocator for the index arrays of one sort.
+ *
+ * The whole block is allocated once, up front. Recursion levels take slices with
+ * allocate() and give them back in LIFO order with release(), so a sort performs a
+ * single heap allocation no matter how deep it recurses.
+ *
+ * Blocks of SORT_ARENA_MAP_BYTES or more are mapped with mmap and unmapped on
+ * destruction, so their pages go back to the system at once instead of staying in the
+ * malloc heap, where the next large block would be placed beside them.
+ */
+class SortArena {
+	public:
+		/**
+		 * @brief Allocates the backing block.
+		 * @param words Capacity in 32-bit words.
+		 */
+		explicit SortArena(size_t words);
+
+		/**
+		 * @brief Releases the backing block.
+		 */
+		~SortArena();
+
+		/**
+		 * @brief Takes a slice of words 32-bit words from the top of the arena.
+		 * @param words Size of the slice.
+		 * @return Pointer to the slice.
+		 * @throws std::length_error if the arena is exhausted.
+		 */
+		uint32_t *allocate(size_t words);
+
+		/**
+		 * @brief Takes a slice of count 64-bit words, aligned to 8 bytes.
+		 * @param count Size of the slice.
+		 * @return Pointer to the slice.
+		 * @throws std::length_error if the arena is exhausted.
+		 */
+		uint64_t *allocateWide(size_t count);
+
+		/**
+		 * @brief Returns the current top of the arena, to be passed to release().
+		 */
+		size_t mark() const;
+
+		/**
+		 * @brief Frees every slice allocated after mark was taken.
+		 * @param mark A value previously returned by mark().
+		 */
+		void release(size_t mark);
+
+		/**
+		 * @brief Capacity of the arena in bytes.
+		 */
+		size_t capacityBytes() const;
+
+		/**
+		 * @brief Highest number of bytes in use at any point so far.
+		 */
+		size_t peakBytes() const;
+
+	private:
+		uint32_t *_base;
+		size_t _capacity;
+		size_t _top;
+		size_t _peak;
+		bool _mapped;
+
+		SortArena(const SortArena &other);
+
+		SortArena &operator=(const SortArena &other);
+};
+
+#endif
@@ -0,0 +1,93 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   SortEngine.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "SortEngine.hpp"
+#include <cstring>
+
+/**
+ * @brief Printable name of an engine, as accepted by parse_sort_engine().
+ */
+const char *sort_engine_name(SortEngine engine) {
+	switch (engine) {
+		case ENGINE_MERGE_INSERTION:
+			return "merge-insertion";
+		case ENGINE_RADIX:
+			return "radix";
+		case ENGINE_INTROSORT:
+			return "introsort";
+		default:
+			return "auto";
+	}
+}
+
+/**
+ * @brief Parses "auto", "merge-insertion", "radix" or "introsort".
+ * @throws std::invalid_argument If name is none of them.
+ */
+SortEngine parse_sort_engine(const std::string &name) {
+	const SortEngine engines[] = { ENGINE_AUTO, ENGINE_MERGE_INSERTION, ENGINE_RADIX, ENGINE_INTROSORT };
+
+	for (size_t i = 0; i < sizeof(engines) / sizeof(engines[0]); i++) {
+		if (name == sort_engine_name(engines[i])) {
+			return engines[i];
+		}
+	}
+	throw std::invalid_argument("Unknown engine " + name);
+}
+
+/**
+ * @brief LSD radix sort of n keys, one byte per pass.
+ *
+ * One read pass builds all four 256-entry histograms, which stay in L1 together with
+ * the 256 write cursors of a pass. A pass whose byte is the same for every key is
+ * skipped, so narrow keys take fewer passes.
+ *
+ * @param data The keys.
+ * @param n Number of keys.
+ * @param buffer Scratch space for n keys.
+ */
+void radix_sort_u32(uint32_t *data, size_t n, uint32_t *buffer) {
+	size_t counts[4][256];
+	std::memset(counts, 0, sizeof(counts));
+
+	for (size_t i = 0; i < n; i++) {
+		uint32_t key = data[i];
+		counts[0][key & 0xff]++;
+		counts[1][key >> 8 & 0xff]++;
+		counts[2][key >> 16 & 0xff]++;
+		counts[3][key >> 24]++;
+	}
+
+	uint32_t *src = data;
+	uint32_t *dst = buffer;
+	for (unsigned pass = 0; pass < 4; pass++) {
+		unsigned shift = pass * 8;
+		if (counts[pass][src[0] >> shift & 0xff] == n) {
+			continue;
+		}
+
+		size_t offsets[256];
+		size_t total = 0;
+		for (unsigned digit = 0; digit < 256; digit++) {
+			offsets[digit] = total;
+			total += counts[pass][digit];
+		}
+		for (size_t i = 0; i < n; i++) {
+			uint32_t key = src[i];
+			dst[offsets[key >> shift & 0xff]++] = key;
+		}
+		std::swap(src, dst);
+	}
+	if (src != data) {
+		std::memcpy(data, src, n * sizeof(uint32_t));
+	}
+}
@@ -0,0 +1,245 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   SortEngine.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef SORTENGINE_HPP
+#define SORTENGINE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "FordJohnson.hpp"
+
+/**
+ * @brief Algorithms PmergeMe can sort with.
+ *
+ * ENGINE_AUTO lets choose_engine() decide. ENGINE_MERGE_INSERTION is Ford-Johnson, which
+ * makes the fewest comparisons. ENGINE_RADIX is an LSD radix sort on 32-bit keys, which
+ * makes none. ENGINE_INTROSORT is std::sort, introsort in every mainstream library.
+ */
+enum SortEngine {
+	ENGINE_AUTO,
+	ENGINE_MERGE_INSERTION,
+	ENGINE_RADIX,
+	ENGINE_INTROSORT
+};
+
+/**
+ * @brief Below this many keys the radix passes cost more than introsort.
+ */
+const size_t RADIX_SORT_MIN_SIZE = 512;
+
+/**
+ * @brief Whether comparing two T is a handful of instructions (built-in arithmetic and pointers).
+ */
+template<typename T>
+struct cheap_key {
+	static const bool value = false;
+};
+
+template<typename T>
+struct cheap_key<T *> {
+	static const bool value = true;
+};
+
+#define CHEAP_KEY(type) \
+	template<> \
+	struct cheap_key<type> { \
+		static const bool value = true; \
+	}
+
+CHEAP_KEY(char);
+CHEAP_KEY(signed char);
+CHEAP_KEY(unsigned char);
+CHEAP_KEY(short);
+CHEAP_KEY(unsigned short);
+CHEAP_KEY(int);
+CHEAP_KEY(unsigned int);
+CHEAP_KEY(long);
+CHEAP_KEY(unsigned long);
+CHEAP_KEY(long long);
+CHEAP_KEY(unsigned long long);
+CHEAP_KEY(float);
+CHEAP_KEY(double);
+
+#undef CHEAP_KEY
+
+/**
+ * @brief Whether a comparator is costly enough that saving comparisons beats raw speed.
+ *
+ * By default a comparator is costly unless it compares cheap keys. Specialize this for
+ * a comparator that does not follow that rule, e.g. a collating string comparison.
+ *
+ * @tparam Compare The comparator.
+ * @tparam T The element type it compares.
+ */
+template<typename Compare, typename T>
+struct comparator_cost {
+	static const bool expensive = !cheap_key<T>::value;
+};
+
+template<typename Compare, typename CountPolicy, typename T>
+struct comparator_cost<CountedCompare<Compare, CountPolicy>, T> {
+	static const bool expensive = comparator_cost<Compare, T>::expensive;
+};
+
+/**
+ * @brief Whether radix_sort() can produce the order of Compare on T.
+ */
+template<typename T, typename Compare>
+struct radix_sortable {
+	static const bool value = false;
+};
+
+template<>
+struct radix_sortable<uint32_t, std::less<uint32_t> > {
+	static const bool value = true;
+};
+
+template<>
+struct radix_sortable<uint32_t, std::greater<uint32_t> > {
+	static const bool value = true;
+};
+
+/**
+ * @brief Complete only for true: naming its size where a radix sort is instantiated turns
+ * an unsupported key type or comparator into a compile error.
+ */
+template<bool Sortable>
+struct radix_sort_requires_uint32_keys;
+
+template<>
+struct radix_sort_requires_uint32_keys<true> {
+};
+
+/**
+ * @brief Printable name of an engine, as accepted by parse_sort_engine().
+ */
+const char *sort_engine_name(SortEngine engine);
+
+/**
+ * @brief Parses "auto", "merge-insertion", "radix" or "introsort".
+ * @throws std::invalid_argument If name is none of them.
+ */
+SortEngine parse_sort_engine(const std::string &name);
+
+/**
+ * @brief LSD radix sort of n keys, one byte per pass.
+ *
+ * @param data The keys.
+ * @param n Number of keys.
+ * @param buffer Scratch space for n keys.
+ */
+void radix_sort_u32(uint32_t *data, size_t n, uint32_t *buffer);
+
+/**
+ * @brief Picks the engine for sorting [first, last) with comp.
+ *
+ * Costly comparators go to merge-insertion; keys radix_sort() handles go to radix once
+ * there are at least RADIX_SORT_MIN_SIZE of them; everything else goes to introsort.
+ *
+ * @return ENGINE_MERGE_INSERTION, ENGINE_RADIX or ENGINE_INTROSORT.
+ */
+template<typename RandomIt, typename Compare>
+SortEngine choose_engine(RandomIt first, RandomIt last, Compare) {
+	typedef typename std::iterator_traits<RandomIt>::value_type T;
+
+	if (comparator_cost<Compare, T>::expensive) {
+		return ENGINE_MERGE_INSERTION;
+	}
+	if (radix_sortable<T, Compare>::value && static_cast<size_t>(last - first) >= RADIX_SORT_MIN_SIZE) {
+		return ENGINE_RADIX;
+	}
+	return ENGINE_INTROSORT;
+}
+
+/**
+ * @brief Radix sort of n contiguous uint32_t in place, with one scratch buffer.
+ */
+inline void radix_sort_contiguous(uint32_t *data, size_t n) {
+	if (n < 2) {
+		return;
+	}
+	std::vector<uint32_t, CountingAllocator<uint32_t> > buffer(n);
+	radix_sort_u32(data, n, &buffer[0]);
+}
+
+/**
+ * @brief Radix sort for contiguous uint32_t: sorts in place with one scratch buffer.
+ */
+inline void radix_sort(std::vector<uint32_t>::iterator first, std::vector<uint32_t>::iterator last,
+	std::less<uint32_t>) {
+	if (first != last) {
+		radix_sort_contiguous(&*first, last - first);
+	}
+}
+
+/**
+ * @brief Same for a vector with a CountingAllocator, so that --memory measures the same sort.
+ */
+inline void radix_sort(std::vector<uint32_t, CountingAllocator<uint32_t> >::iterator first,
+	std::vector<uint32_t, CountingAllocator<uint32_t> >::iterator last, std::less<uint32_t>) {
+	if (first != last) {
+		radix_sort_contiguous(&*first, last - first);
+	}
+}
+
+/**
+ * @brief Radix sort for other uint32_t ranges: gathers the keys into contiguous storage.
+ */
+template<typename RandomIt>
+void radix_sort(RandomIt first, RandomIt last, std::less<uint32_t>) {
+	typedef typename std::iterator_traits<RandomIt>::value_type T;
+
+	(void)sizeof(radix_sort_requires_uint32_keys<radix_sortable<T, std::less<uint32_t> >::value>);
+	if (last - first < 2) {
+		return;
+	}
+	std::vector<uint32_t, CountingAllocator<uint32_t> > keys(first, last);
+	std::vector<uint32_t, CountingAllocator<uint32_t> > buffer(keys.size());
+
+	radix_sort_u32(&keys[0], keys.size(), &buffer[0]);
+	std::copy(keys.begin(), keys.end(), first);
+}
+
+/**
+ * @brief Descending radix sort: ascending, then reversed.
+ */
+template<typename RandomIt>
+void radix_sort(RandomIt first, RandomIt last, std::greater<uint32_t>) {
+	radix_sort(first, last, std::less<uint32_t>());
+	std::reverse(first, last);
+}
+
+/**
+ * @brief Any other comparator cannot be radix-sorted: instantiating this fails to compile.
+ */
+template<typename RandomIt, typename Compare>
+void radix_sort(RandomIt, RandomIt, Compare) {
+	typedef typename std::iterator_traits<RandomIt>::value_type T;
+
+	(void)sizeof(radix_sort_requires_uint32_keys<radix_sortable<T, Compare>::value>);
+}
+
+/**
+ * @brief Introsort of [first, last).
+ */
+template<typename RandomIt, typename Compare>
+void introsort(RandomIt first, RandomIt last, Compare comp) {
+	std::sort(first, last, comp);
+}
+
+#endif
@@ -0,0 +1,300 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ThreadPool.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <unistd.h>
+
+RangeTask::~RangeTask() {
+}
+
+/**
+ * @brief Starts threads - 1 workers; the caller is the remaining participant.
+ * @param threads Total number of participants, at least 1.
+ */
+ThreadPool::ThreadPool(size_t threads) : _queued(0), _pending(0), _stop(false) {
+	if (threads == 0) {
+		threads = 1;
+	}
+	pthread_mutex_init(&_lock, NULL);
+	pthread_cond_init(&_wake, NULL);
+	pthread_cond_init(&_done, NULL);
+
+	for (size_t i = 0; i < threads; i++) {
+		Queue *queue = new Queue;
+		pthread_mutex_init(&queue->lock, NULL);
+		_queues.push_back(queue);
+	}
+	for (size_t i = 1; i < threads; i++) {
+		Worker *worker = new Worker;
+		worker->pool = this;
+		worker->index = i;
+		if (pthread_create(&worker->thread, NULL, _workerMain, worker) != 0) {
+			delete worker;
+			_shutdown();
+			throw std::runtime_error("ThreadPool: cannot start worker thread");
+		}
+		_workers.push_back(worker);
+	}
+}
+
+/**
+ * @brief Stops and joins the workers.
+ */
+ThreadPool::~ThreadPool() {
+	_shutdown();
+}
+
+/**
+ * @brief Stops and joins the workers, then releases the queues and primitives.
+ */
+void ThreadPool::_shutdown() {
+	pthread_mutex_lock(&_lock);
+	_stop = true;
+	pthread_cond_broadcast(&_wake);
+	pthread_mutex_unlock(&_lock);
+
+	for (size_t i = 0; i < _workers.size(); i++) {
+		pthread_join(_workers[i]->thread, NULL);
+		delete _workers[i];
+	}
+	_workers.clear();
+	for (size_t i = 0; i < _queues.size(); i++) {
+		pthread_mutex_destroy(&_queues[i]->lock);
+		delete _queues[i];
+	}
+	_queues.clear();
+	pthread_cond_destroy(&_done);
+	pthread_cond_destroy(&_wake);
+	pthread_mutex_destroy(&_lock);
+}
+
+/**
+ * @brief Number of participants, including the calling thread.
+ */
+size_t ThreadPool::threads() const {
+	return _queues.size();
+}
+
+/**
+ * @brief Runs task over [begin, end) in chunks of at least grain indices.
+ */
+void ThreadPool::parallelFor(size_t begin, size_t end, size_t grain, RangeTask &task) {
+	if (begin >= end) {
+		return;
+	}
+	size_t length = end - begin;
+	if (grain == 0) {
+		grain = 1;
+	}
+	if (_queues.size() == 1 || length <= grain) {
+		task.run(begin, end);
+		return;
+	}
+
+	// A few chunks per participant leave room for stealing without tiny jobs.
+	size_t chunks = std::min((length + grain - 1) / grain, _queues.size() * 4);
+	size_t step = (length + chunks - 1) / chunks;
+	chunks = (length + step - 1) / step;
+
+	pthread_mutex_lock(&_lock);
+	_pending += chunks;
+	pthread_mutex_unlock(&_lock);
+
+	for (size_t c = 0; c < chunks; c++) {
+		Job job;
+		job.task = &task;
+		job.begin = begin + c * step;
+		job.end = std::min(end, job.begin + step);
+
+		Queue *queue = _queues[c % _queues.size()];
+		pthread_mutex_lock(&queue->lock);
+		queue->jobs.push_back(job);
+		pthread_mutex_unlock(&queue->lock);
+	}
+
+	pthread_mutex_lock(&_lock);
+	_queued += chunks;
+	pthread_cond_broadcast(&_wake);
+	pthread_mutex_unlock(&_lock);
+
+	// Help until every chunk has finished.
+	while (true) {
+		if (_runOne(0)) {
+			continue;
+		}
+		pthread_mutex_lock(&_lock);
+		while (_pending != 0 && _queued == 0) {
+			pthread_cond_wait(&_done, &_lock);
+		}
+		bool finished = _pending == 0;
+		pthread_mutex_unlock(&_lock);
+		if (finished) {
+			break;
+		}
+	}
+}
+
+/**
+ * @brief Worker loop: run jobs while there are any, sleep otherwise.
+ */
+void *ThreadPool::_workerMain(void *arg) {
+	Worker *worker = static_cast<Worker *>(arg);
+	ThreadPool *pool = worker->pool;
+
+	while (true) {
+		if (pool->_runOne(worker->index)) {
+			continue;
+		}
+		pthread_mutex_lock(&pool->_lock);
+		while (pool->_queued == 0 && !pool->_stop) {
+			pthread_cond_wait(&pool->_wake, &pool->_lock);
+		}
+		bool stop = pool->_stop;
+		pthread_mutex_unlock(&pool->_lock);
+		if (stop) {
+			return NULL;
+		}
+	}
+}
+
+/**
+ * @brief Runs one job: the newest of our own, or the oldest of another participant.
+ * @return False if no job could be found.
+ */
+bool ThreadPool::_runOne(size_t self) {
+	Job job;
+	bool found = false;
+
+	for (size_t i = 0; i < _queues.size() && !found; i++) {
+		Queue *queue = _queues[(self + i) % _queues.size()];
+		pthread_mutex_lock(&queue->lock);
+		if (!queue->jobs.empty()) {
+			if (i == 0) {
+				job = queue->jobs.back();
+				queue->jobs.pop_back();
+			} else {
+				job = queue->jobs.front();
+				queue->jobs.pop_front();
+			}
+			found = true;
+		}
+		pthread_mutex_unlock(&queue->lock);
+	}
+	if (!found) {
+		return false;
+	}
+
+	pthread_mutex_lock(&_lock);
+	_queued--;
+	pthread_mutex_unlock(&_lock);
+
+	job.task->run(job.begin, job.end);
+
+	pthread_mutex_lock(&_lock);
+	if (--_pending == 0) {
+		pthread_cond_broadcast(&_done);
+	}
+	pthread_mutex_unlock(&_lock);
+	return true;
+}
+
+/**
+ * @brief Number of online processors, at least 1.
+ */
+size_t hardware_threads() {
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+	return count > 0 ? static_cast<size_t>(count) : 1;
+}
+
+namespace {
+
+	/**
+	 * @brief Sorts fixed-width blocks of keys independently.
+	 */
+	class SortBlocksTask : public RangeTask {
+		public:
+			SortBlocksTask(uint64_t *data, size_t n, size_t width) : _data(data), _n(n), _width(width) {}
+
+			void run(size_t begin, size_t end) {
+				for (size_t b = begin; b < end; b++) {
+					std::sort(_data + b * _width, _data + std::min(_n, (b + 1) * _width));
+				}
+			}
+
+		private:
+			uint64_t *_data;
+			size_t _n;
+			size_t _width;
+	};
+
+	/**
+	 * @brief Merges adjacent sorted runs of a given width from src into dst.
+	 */
+	class MergeRunsTask : public RangeTask {
+		public:
+			MergeRunsTask(const uint64_t *src, uint64_t *dst, size_t n, size_t width)
+				: _src(src), _dst(dst), _n(n), _width(width) {}
+
+			void run(size_t begin, size_t end) {
+				for (size_t p = begin; p < end; p++) {
+					size_t lo = p * 2 * _width;
+					size_t mid = std::min(_n, lo + _width);
+					size_t hi = std::min(_n, mid + _width);
+					std::merge(_src + lo, _src + mid, _src + mid, _src + hi, _dst + lo);
+				}
+			}
+
+		private:
+			const uint64_t *_src;
+			uint64_t *_dst;
+			size_t _n;
+			size_t _width;
+	};
+}
+
+/**
+ * @brief Sorts n 64-bit keys with the pool: chunks in parallel, then parallel merge rounds.
+ *
+ * @param data The keys to sort.
+ * @param buffer Scratch space for n keys.
+ * @param n Number of keys.
+ * @param pool The thread pool.
+ */
+void parallel_sort(uint64_t *data, uint64_t *buffer, size_t n, ThreadPool &pool) {
+	size_t blocks = pool.threads();
+	size_t width = (n + blocks - 1) / blocks;
+
+	if (blocks == 1 || width == 0) {
+		std::sort(data, data + n);
+		return;
+	}
+	// With more threads than keys per block the rounded width leaves trailing blocks
+	// empty, and they would start past n; drop them.
+	blocks = (n + width - 1) / width;
+
+	SortBlocksTask sort_blocks(data, n, width);
+	pool.parallelFor(0, blocks, 1, sort_blocks);
+
+	uint64_t *src = data;
+	uint64_t *dst = buffer;
+	for (; width < n; width *= 2) {
+		MergeRunsTask merge_runs(src, dst, n, width);
+		pool.parallelFor(0, (n + 2 * width - 1) / (2 * width), 1, merge_runs);
+		std::swap(src, dst);
+	}
+	if (src != data) {
+		std::copy(src, src + n, data);
+	}
+}
@@ -0,0 +1,146 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ThreadPool.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+#include <pthread.h>
+#include <stdint.h>
+
+/**
+ * @class RangeTask
+ * @brief A unit of data-parallel work over an index range.
+ */
+class RangeTask {
+	public:
+		virtual ~RangeTask();
+
+		/**
+		 * @brief Processes the indices [begin, end).
+		 */
+		virtual void run(size_t begin, size_t end) = 0;
+};
+
+/**
+ * @class MethodTask
+ * @brief RangeTask calling a member function of an object.
+ *
+ * @tparam Owner Class of the object whose method processes a range.
+ */
+template<typename Owner>
+class MethodTask : public RangeTask {
+	public:
+		typedef void (Owner::*Method)(size_t begin, size_t end);
+
+		MethodTask(Owner &owner, Method method) : _owner(owner), _method(method) {}
+
+		void run(size_t begin, size_t end) {
+			(_owner.*_method)(begin, end);
+		}
+
+	private:
+		Owner &_owner;
+		Method _method;
+};
+
+/**
+ * @class ThreadPool
+ * @brief Fixed set of worker threads with per-worker job deques and work stealing.
+ *
+ * parallelFor() cuts a range into chunks and deals them round-robin into the deques. A
+ * worker pops from the back of its own deque and, once that is empty, steals from the
+ * front of the others, so uneven chunks balance out. The calling thread takes part as
+ * participant 0 and returns when every chunk has run.
+ */
+class ThreadPool {
+	public:
+		/**
+		 * @brief Starts threads - 1 workers; the caller is the remaining participant.
+		 * @param threads Total number of participants, at least 1.
+		 */
+		explicit ThreadPool(size_t threads);
+
+		/**
+		 * @brief Stops and joins the workers.
+		 */
+		~ThreadPool();
+
+		/**
+		 * @brief Number of participants, including the calling thread.
+		 */
+		size_t threads() const;
+
+		/**
+		 * @brief Runs task over [begin, end) in chunks of at least grain indices.
+		 *
+		 * Runs inline when the range is no larger than grain or the pool has one thread.
+		 * Must not be called from inside a task.
+		 */
+		void parallelFor(size_t begin, size_t end, size_t grain, RangeTask &task);
+
+	private:
+		struct Job {
+			RangeTask *task;
+			size_t begin;
+			size_t end;
+		};
+
+		struct Queue {
+			pthread_mutex_t lock;
+			std::deque<Job> jobs;
+		};
+
+		struct Worker {
+			ThreadPool *pool;
+			size_t index;
+			pthread_t thread;
+		};
+
+		std::vector<Queue *> _queues;
+		std::vector<Worker *> _workers;
+		pthread_mutex_t _lock;
+		pthread_cond_t _wake;
+		pthread_cond_t _done;
+		size_t _queued;
+		size_t _pending;
+		bool _stop;
+
+		static void *_workerMain(void *arg);
+
+		bool _runOne(size_t self);
+
+		void _shutdown();
+
+		ThreadPool(const ThreadPool &other);
+
+		ThreadPool &operator=(const ThreadPool &other);
+};
+
+/**
+ * @brief Number of online processors, at least 1.
+ */
+size_t hardware_threads();
+
+/**
+ * @brief Sorts n 64-bit keys with the pool: chunks in parallel, then parallel merge rounds.
+ *
+ * @param data The keys to sort.
+ * @param buffer Scratch space for n keys.
+ * @param n Number of keys.
+ * @param pool The thread pool.
+ */
+void parallel_sort(uint64_t *data, uint64_t *buffer, size_t n, ThreadPool &pool);
+
+#endif
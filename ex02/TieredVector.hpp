@@ -0,0 +1,334 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   TieredVector.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef TIEREDVECTOR_HPP
+#define TIEREDVECTOR_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+template<typename T, typename Alloc>
+class TieredVector;
+
+/**
+ * @class TieredVectorIterator
+ * @brief Random-access iterator over a TieredVector: the container and an index.
+ *
+ * @tparam Container TieredVector, const for const iteration.
+ * @tparam Value Element type, const for const iteration.
+ */
+template<typename Container, typename Value>
+class TieredVectorIterator {
+	public:
+		typedef std::random_access_iterator_tag iterator_category;
+		typedef typename Container::value_type value_type;
+		typedef ptrdiff_t difference_type;
+		typedef Value *pointer;
+		typedef Value &reference;
+
+		TieredVectorIterator() : _container(NULL), _index(0) {}
+
+		TieredVectorIterator(Container *container, size_t index) : _container(container), _index(index) {}
+
+		template<typename OtherContainer, typename OtherValue>
+		TieredVectorIterator(const TieredVectorIterator<OtherContainer, OtherValue> &other)
+			: _container(other.container()), _index(other.index()) {}
+
+		Container *container() const {
+			return _container;
+		}
+
+		size_t index() const {
+			return _index;
+		}
+
+		reference operator*() const {
+			return _container->_slot(_index);
+		}
+
+		pointer operator->() const {
+			return &_container->_slot(_index);
+		}
+
+		reference operator[](difference_type n) const {
+			return _container->_slot(_index + n);
+		}
+
+		TieredVectorIterator &operator++() {
+			++_index;
+			return *this;
+		}
+
+		TieredVectorIterator operator++(int) {
+			TieredVectorIterator old(*this);
+			++_index;
+			return old;
+		}
+
+		TieredVectorIterator &operator--() {
+			--_index;
+			return *this;
+		}
+
+		TieredVectorIterator operator--(int) {
+			TieredVectorIterator old(*this);
+			--_index;
+			return old;
+		}
+
+		TieredVectorIterator &operator+=(difference_type n) {
+			_index += n;
+			return *this;
+		}
+
+		TieredVectorIterator &operator-=(difference_type n) {
+			_index -= n;
+			return *this;
+		}
+
+		TieredVectorIterator operator+(difference_type n) const {
+			return TieredVectorIterator(_container, _index + n);
+		}
+
+		TieredVectorIterator operator-(difference_type n) const {
+			return TieredVectorIterator(_container, _index - n);
+		}
+
+		difference_type operator-(const TieredVectorIterator &other) const {
+			return static_cast<difference_type>(_index) - static_cast<difference_type>(other._index);
+		}
+
+		bool operator==(const TieredVectorIterator &other) const {
+			return _index == other._index;
+		}
+
+		bool operator!=(const TieredVectorIterator &other) const {
+			return _index != other._index;
+		}
+
+		bool operator<(const TieredVectorIterator &other) const {
+			return _index < other._index;
+		}
+
+		bool operator>(const TieredVectorIterator &other) const {
+			return _index > other._index;
+		}
+
+		bool operator<=(const TieredVectorIterator &other) const {
+			return _index <= other._index;
+		}
+
+		bool operator>=(const TieredVectorIterator &other) const {
+			return _index >= other._index;
+		}
+
+	private:
+		Container *_container;
+		size_t _index;
+};
+
+template<typename Container, typename Value>
+TieredVectorIterator<Container, Value> operator+(ptrdiff_t n, const TieredVectorIterator<Container, Value> &it) {
+	return it + n;
+}
+
+/**
+ * @class TieredVector
+ * @brief Sequence of fixed-size circular chunks with O(1) indexing, O(log n) sorted
+ * search and O(sqrt n) insertion anywhere.
+ *
+ * Every chunk but the last is full, so element i lives in chunk i / C at offset
+ * (head + i) % C of that chunk's ring. Inserting shifts the smaller side of one chunk
+ * and then carries one element from the back of each later chunk to the front of the
+ * next, which is O(1) per chunk thanks to the rings: O(C + n / C) moves, O(sqrt n) with
+ * C near sqrt(n), which reserve() picks. lowerBound() binary-searches the ranks
+ * directly, since indexing costs only a shift and a mask.
+ *
+ * @tparam T Element type; must be default-constructible.
+ * @tparam Alloc Allocator of T, used for all storage.
+ */
+template<typename T, typename Alloc = std::allocator<T> >
+class TieredVector {
+	public:
+		typedef T value_type;
+		typedef Alloc allocator_type;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+		typedef T &reference;
+		typedef const T &const_reference;
+		typedef TieredVectorIterator<TieredVector, T> iterator;
+		typedef TieredVectorIterator<const TieredVector, const T> const_iterator;
+
+		TieredVector() : _shift(DEFAULT_SHIFT), _size(0) {}
+
+		size_t size() const {
+			return _size;
+		}
+
+		bool empty() const {
+			return _size == 0;
+		}
+
+		/**
+		 * @brief Prepares for n elements; while empty, also sizes the chunks near sqrt(n).
+		 */
+		void reserve(size_t n) {
+			if (_size == 0) {
+				_shift = MIN_SHIFT;
+				while (_shift < MAX_SHIFT && (static_cast<size_t>(1) << (2 * _shift)) < n) {
+					_shift++;
+				}
+			}
+			size_t chunks = (n >> _shift) + 1;
+			_data.reserve(chunks << _shift);
+			_head.reserve(chunks);
+		}
+
+		reference operator[](size_t i) {
+			return _slot(i);
+		}
+
+		const_reference operator[](size_t i) const {
+			return _slot(i);
+		}
+
+		reference back() {
+			return (*this)[_size - 1];
+		}
+
+		const_reference back() const {
+			return _slot(_size - 1);
+		}
+
+		iterator begin() {
+			return iterator(this, 0);
+		}
+
+		iterator end() {
+			return iterator(this, _size);
+		}
+
+		const_iterator begin() const {
+			return const_iterator(this, 0);
+		}
+
+		const_iterator end() const {
+			return const_iterator(this, _size);
+		}
+
+		void push_back(const T &value) {
+			insertAt(_size, value);
+		}
+
+		/**
+		 * @brief Inserts value before pos.
+		 * @return Iterator to the inserted element.
+		 */
+		iterator insert(iterator pos, const T &value) {
+			insertAt(pos.index(), value);
+			return iterator(this, pos.index());
+		}
+
+		/**
+		 * @brief Inserts value so that it becomes element rank.
+		 */
+		void insertAt(size_t rank, const T &value) {
+			size_t mask = _mask();
+			if (_size == _data.size()) {
+				_data.resize(_data.size() + mask + 1);
+				_head.push_back(0);
+			}
+
+			size_t chunk = rank >> _shift;
+			size_t last = _size >> _shift;
+			// Carry the back of every full chunk after the target to the front of the next.
+			for (size_t j = last; j > chunk; j--) {
+				const T &carried = _ring(j - 1, mask);
+				_head[j] = (_head[j] - 1) & mask;
+				_ring(j, 0) = carried;
+			}
+
+			size_t count = chunk < last ? mask : _size & mask;
+			size_t offset = rank & mask;
+			if (offset < count / 2) {
+				_head[chunk] = (_head[chunk] - 1) & mask;
+				for (size_t p = 0; p < offset; p++) {
+					_ring(chunk, p) = _ring(chunk, p + 1);
+				}
+			} else {
+				for (size_t p = count; p > offset; p--) {
+					_ring(chunk, p) = _ring(chunk, p - 1);
+				}
+			}
+			_ring(chunk, offset) = value;
+			_size++;
+		}
+
+		/**
+		 * @brief Rank of the first element that is not less than value, in a sorted vector.
+		 *
+		 * One binary search over global ranks through the O(1) indexing, probing the same
+		 * ranks as std::lower_bound on a vector of the same elements, so both chains
+		 * spend the same comparisons.
+		 */
+		template<typename Compare>
+		size_t lowerBound(const T &value, Compare comp) const {
+			size_t first = 0;
+			size_t len = _size;
+			while (len > 0) {
+				size_t half = len >> 1;
+				if (comp(_slot(first + half), value)) {
+					first += half + 1;
+					len -= half + 1;
+				} else {
+					len = half;
+				}
+			}
+			return first;
+		}
+
+	private:
+		typedef typename Alloc::template rebind<size_t>::other IndexAllocator;
+
+		static const size_t DEFAULT_SHIFT = 8;
+		static const size_t MIN_SHIFT = 4;
+		static const size_t MAX_SHIFT = 16;
+
+		size_t _shift;
+		size_t _size;
+		std::vector<T, Alloc> _data;
+		std::vector<size_t, IndexAllocator> _head;
+
+		template<typename Container, typename Value>
+		friend class TieredVectorIterator;
+
+		size_t _mask() const {
+			return (static_cast<size_t>(1) << _shift) - 1;
+		}
+
+		T &_ring(size_t chunk, size_t offset) {
+			return _data[(chunk << _shift) + ((_head[chunk] + offset) & _mask())];
+		}
+
+		T &_slot(size_t i) {
+			return _ring(i >> _shift, i & _mask());
+		}
+
+		const T &_slot(size_t i) const {
+			size_t chunk = i >> _shift;
+			return _data[(chunk << _shift) + ((_head[chunk] + i) & _mask())];
+		}
+};
+
+#endif
@@ -0,0 +1,161 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   TopK.hpp                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rjeong <rjeong@student.42seoul.kr>         +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:10:00 by rjeong            #+#    #+#             */
+/*   Updated: 2026/10/18 21:10:00 by rjeong           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef TOPK_HPP
+#define TOPK_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include "FordJohnson.hpp"
+#include "MergeInsertion.hpp"
+
+/**
+ * @brief From this k on, top_k() selects with nth_element instead of keeping a sorted buffer.
+ */
+const size_t TOP_K_SELECT_MIN = 256;
+
+/**
+ * @brief Sorts the kept prefix with merge-insertion on an order-statistic tree chain,
+ * which keeps it O(k log k) however large k is.
+ */
+template<typename Container, typename Compare>
+void top_k_sort_prefix(Container &out, Compare comp, const MergeInsertionOptions &options) {
+	MergeInsertionOptions prefix = options;
+
+	prefix.chain = TREE_CHAIN;
+	merge_insertion_sort(out.begin(), out.end(), comp, prefix);
+}
+
+/**
+ * @brief Slots worth reserving for up to wanted elements of a single-pass input: none,
+ * since its length is unknown and the buffer grows as it fills.
+ */
+template<typename InputIt>
+size_t top_k_reserve(InputIt, InputIt, size_t, std::input_iterator_tag) {
+	return 0;
+}
+
+/**
+ * @brief Slots worth reserving for up to wanted elements of [first, last): never more than
+ * the input holds, so a k far beyond n costs nothing.
+ */
+template<typename ForwardIt>
+size_t top_k_reserve(ForwardIt first, ForwardIt last, size_t wanted, std::forward_iterator_tag) {
+	return std::min(wanted, static_cast<size_t>(std::distance(first, last)));
+}
+
+/**
+ * @brief Reservation for up to wanted elements of [first, last), capped at its length.
+ */
+template<typename InputIt>
+size_t top_k_reserve(InputIt first, InputIt last, size_t wanted) {
+	return top_k_reserve(first, last, wanted, typename std::iterator_traits<InputIt>::iterator_category());
+}
+
+/**
+ * @brief Smallest k elements of [first, last), in order, kept in a sorted buffer.
+ *
+ * The first k elements are sorted once; after that an element that is not below the
+ * current k-th costs one comparison and is dropped, and only the others are
+ * binary-inserted, pushing the largest one out. O(n + m log k) comparisons for m
+ * insertions and k elements of memory, but every insertion shifts up to k elements, so
+ * this suits small k.
+ *
+ * @param out Receives the result; its previous contents are discarded.
+ */
+template<typename InputIt, typename Container, typename Compare>
+void top_k_bounded(InputIt first, InputIt last, size_t k, Compare comp, Container &out,
+	const MergeInsertionOptions &options = MergeInsertionOptions()) {
+	out.clear();
+	if (k == 0) {
+		return;
+	}
+	reserve_chain(out, top_k_reserve(first, last, k));
+	for (; first != last && out.size() < k; ++first) {
+		out.push_back(*first);
+	}
+	top_k_sort_prefix(out, comp, options);
+
+	for (; first != last; ++first) {
+		if (!comp(*first, out.back())) {
+			continue;
+		}
+		typename Container::iterator slot = std::upper_bound(out.begin(), out.end() - 1, *first, comp);
+		std::copy_backward(slot, out.end() - 1, out.end());
+		*slot = *first;
+	}
+}
+
+/**
+ * @brief Smallest k elements of [first, last), in order, found by repeated selection.
+ *
+ * Candidates collect in a buffer of 2k. Whenever it fills, nth_element keeps the k
+ * smallest and the k-th becomes a threshold that later elements must beat to enter. Each
+ * round costs O(k) and admits k elements, so the scan is O(n) on average with
+ * min(2k, n) elements of memory; the final prefix is sorted once.
+ *
+ * @param out Receives the result; its previous contents are discarded.
+ */
+template<typename InputIt, typename Container, typename Compare>
+void top_k_select(InputIt first, InputIt last, size_t k, Compare comp, Container &out,
+	const MergeInsertionOptions &options = MergeInsertionOptions()) {
+	out.clear();
+	if (k == 0) {
+		return;
+	}
+	reserve_chain(out, top_k_reserve(first, last, 2 * k));
+	bool bounded = false;
+
+	for (; first != last; ++first) {
+		// out[k - 1] is the threshold; appending after it never moves it.
+		if (bounded && !comp(*first, out[k - 1])) {
+			continue;
+		}
+		out.push_back(*first);
+		if (out.size() == 2 * k) {
+			std::nth_element(out.begin(), out.begin() + (k - 1), out.end(), comp);
+			out.resize(k);
+			bounded = true;
+		}
+	}
+	if (out.size() > k) {
+		std::nth_element(out.begin(), out.begin() + k, out.end(), comp);
+		out.resize(k);
+	}
+	top_k_sort_prefix(out, comp, options);
+}
+
+/**
+ * @brief Smallest k elements of [first, last) in sorted order, in O(n log k) time and
+ * O(min(k, n)) memory.
+ *
+ * Uses top_k_bounded() below TOP_K_SELECT_MIN and top_k_select() from there on.
+ *
+ * @param first Beginning of the input.
+ * @param last End of the input.
+ * @param k Number of elements wanted; the whole input, sorted, if it has fewer.
+ * @param comp Strict weak ordering on the element type.
+ * @param out Receives the result; its previous contents are discarded.
+ * @param options Tuning of the merge-insertion sort of the prefix.
+ */
+template<typename InputIt, typename Container, typename Compare>
+void top_k(InputIt first, InputIt last, size_t k, Compare comp, Container &out,
+	const MergeInsertionOptions &options = MergeInsertionOptions()) {
+	if (k < TOP_K_SELECT_MIN) {
+		top_k_bounded(first, last, k, comp, out, options);
+	} else {
+		top_k_select(first, last, k, comp, out, options);
+	}
+}
+
+#endif
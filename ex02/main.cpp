@@ -11,8 +11,230 @@
 /* ************************************************************************** */
 
 #include "PmergeMe.hpp"
+#include "SortEngine.hpp"
+#include "Benchmark.hpp"
+#include "ExternalSort.hpp"
+#include "OutputWriter.hpp"
+#include "SimdKernels.hpp"
+#include "TopK.hpp"
 #include <iostream>
-#include <ctime>
+#include <fstream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <time.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+/**
+ * @brief Command-line options selecting how the containers are sorted.
+ */
+struct Options {
+	bool arena;
+	bool count;
+	bool crossover;
+	bool compare_count;
+	bool benchmark;
+	BenchmarkConfig bench;
+	bool stdin_input;
+	std::string text_input;
+	std::string binary_input;
+	SortEngine sort_engine;
+	bool engine_given;
+	size_t top_k;
+	bool quiet;
+	bool memory;
+	std::string binary_output;
+	MergeInsertionOptions engine;
+	std::string external_output;
+	ExternalSortConfig external;
+
+	Options() : arena(false), count(false), crossover(false), compare_count(false), benchmark(false), stdin_input(false),
+		sort_engine(ENGINE_MERGE_INSERTION), engine_given(false), top_k(0), quiet(false), memory(false) {}
+
+	bool hasInputSource() const {
+		return stdin_input || !text_input.empty() || !binary_input.empty();
+	}
+};
+
+/**
+ * @brief What a sort reports besides its running time.
+ */
+struct SortReport {
+	SortEngine engine;
+	MergeInsertionStats memory;
+	AllocationStats allocation;
+	unsigned long comparisons;
+
+	SortReport() : engine(ENGINE_MERGE_INSERTION), comparisons(0) {}
+};
+
+/**
+ * @brief std::vector and std::deque whose every allocation is counted, for --memory.
+ */
+typedef std::vector<uint32_t, CountingAllocator<uint32_t> > CountedVector;
+typedef std::deque<uint32_t, CountingAllocator<uint32_t> > CountedDeque;
+
+/**
+ * @brief A 64-byte record, ordered by a text key and then by its number.
+ */
+struct Record {
+	char key[12];
+	uint32_t value;
+	char payload[48];
+};
+
+/**
+ * @brief Multi-field record ordering: strcmp on the key, then the number.
+ */
+struct RecordLess {
+	bool operator()(const Record &a, const Record &b) const {
+		int order = std::strcmp(a.key, b.key);
+		return order != 0 ? order < 0 : a.value < b.value;
+	}
+};
+
+/**
+ * @brief Builds the record of a number: key "item-" plus its last three digits.
+ */
+Record make_record(uint32_t value) {
+	Record record;
+	uint32_t group = value % 1000;
+
+	std::memcpy(record.key, "item-", 5);
+	record.key[5] = static_cast<char>('0' + group / 100);
+	record.key[6] = static_cast<char>('0' + group / 10 % 10);
+	record.key[7] = static_cast<char>('0' + group % 10);
+	std::memset(record.key + 8, 0, sizeof(record.key) - 8);
+	record.value = value;
+	std::memset(record.payload, static_cast<int>(value & 0x7f), sizeof(record.payload));
+	return record;
+}
+
+/**
+ * @brief Parses the numeric value of an option such as --threads=N or --runs=N.
+ *
+ * @param value The text after the "=".
+ * @param min Smallest accepted value.
+ * @param max Largest accepted value.
+ * @return The value.
+ * @throws std::invalid_argument If value is not a number from min to max.
+ */
+size_t parse_count(const std::string &value, size_t min, size_t max) {
+	uint32_t count = str_to_uint(value.c_str());
+
+	if (value.empty() || count < min || count > max) {
+		throw std::invalid_argument("Invalid option value " + value);
+	}
+	return count;
+}
+
+/**
+ * @brief Parses a byte size such as 512M for --mem-limit: a number with an optional K, M or
+ * G suffix (powers of 1024).
+ *
+ * @throws std::invalid_argument If value is not such a size.
+ */
+size_t parse_memory_size(const std::string &value) {
+	size_t digits = value.find_first_not_of("0123456789");
+	std::string number = value.substr(0, digits);
+	std::string suffix = digits == std::string::npos ? "" : value.substr(digits);
+	int shift = 0;
+
+	if (suffix == "K" || suffix == "k") {
+		shift = 10;
+	} else if (suffix == "M" || suffix == "m") {
+		shift = 20;
+	} else if (suffix == "G" || suffix == "g") {
+		shift = 30;
+	} else if (!suffix.empty()) {
+		throw std::invalid_argument("Invalid memory size " + value);
+	}
+
+	uint64_t size = parse_count(number, 1, UINT32_MAX);
+	if (size > static_cast<uint64_t>(static_cast<size_t>(-1)) >> shift) {
+		throw std::invalid_argument("Invalid memory size " + value);
+	}
+	return static_cast<size_t>(size << shift);
+}
+
+/**
+ * @brief Parses the leading "--" options.
+ *
+ * @param argc Number of command-line arguments.
+ * @param argv Array of argument strings.
+ * @param options Receives the parsed options.
+ * @return Index of the first argument that is not an option.
+ * @throws std::invalid_argument If an option is unknown.
+ */
+int parse_options(int argc, char **argv, Options &options) {
+	int i = 1;
+
+	for (; i < argc && std::string(argv[i]).compare(0, 2, "--") == 0; i++) {
+		std::string option = argv[i];
+		if (option == "--arena") {
+			options.arena = true;
+		} else if (option == "--jacobsthal") {
+			options.arena = true;
+			options.count = true;
+			options.engine.order = JACOBSTHAL_ORDER;
+		} else if (option == "--tree") {
+			options.arena = true;
+			options.engine.chain = TREE_CHAIN;
+		} else if (option == "--crossover") {
+			options.crossover = true;
+		} else if (option == "--compare-count") {
+			options.compare_count = true;
+		} else if (option == "--bench") {
+			options.benchmark = true;
+		} else if (option.compare(0, 7, "--runs=") == 0) {
+			options.bench.runs = parse_count(option.substr(7), 1, 100000);
+		} else if (option.compare(0, 9, "--warmup=") == 0) {
+			options.bench.warmup = parse_count(option.substr(9), 0, 100000);
+		} else if (option.compare(0, 7, "--simd=") == 0) {
+			set_simd_level(parse_simd_level(option.substr(7)));
+		} else if (option.compare(0, 9, "--engine=") == 0) {
+			options.sort_engine = parse_sort_engine(option.substr(9));
+			options.engine_given = true;
+		} else if (option == "--stdin") {
+			options.stdin_input = true;
+		} else if (option.compare(0, 8, "--input=") == 0 && option.size() > 8) {
+			options.text_input = option.substr(8);
+		} else if (option.compare(0, 9, "--binary=") == 0 && option.size() > 9) {
+			options.binary_input = option.substr(9);
+		} else if (option == "--memory") {
+			options.memory = true;
+			options.engine.count_depth = true;
+		} else if (option == "--quiet") {
+			options.quiet = true;
+		} else if (option.compare(0, 16, "--binary-output=") == 0 && option.size() > 16) {
+			options.binary_output = option.substr(16);
+		} else if (option.compare(0, 8, "--top-k=") == 0) {
+			options.top_k = parse_count(option.substr(8), 1, UINT32_MAX);
+		} else if (option.compare(0, 11, "--external=") == 0 && option.size() > 11) {
+			options.external_output = option.substr(11);
+		} else if (option.compare(0, 12, "--mem-limit=") == 0) {
+			options.external.memory_limit = parse_memory_size(option.substr(12));
+		} else if (option.compare(0, 11, "--temp-dir=") == 0 && option.size() > 11) {
+			options.external.temp_dir = option.substr(11);
+		} else if (option.compare(0, 10, "--threads=") == 0) {
+			options.arena = true;
+			options.engine.order = JACOBSTHAL_ORDER;
+			options.engine.threads = parse_count(option.substr(10), 0, 1024);
+			if (options.engine.threads == 0) {
+				options.engine.threads = hardware_threads();
+			}
+		} else {
+			throw std::invalid_argument("Unknown option " + option);
+		}
+	}
+	// Counting is not thread-safe, and the parallel schedule is not the Ford-Johnson one.
+	if (options.engine.threads > 1) {
+		options.count = false;
+	}
+	return i;
+}
 
 /**
  * @brief Parses input arguments into a vector of integers.
@@ -20,14 +242,15 @@
  * This function takes command-line arguments, converts them into unsigned integers,
  * and stores them in a vector. It throws exceptions if the arguments are invalid.
  *
+ * @param first Index of the first number in argv.
  * @param argc Number of command-line arguments.
  * @param argv Array of argument strings.
  * @return A vector of parsed unsigned integers.
  */
-std::vector <uint32_t> parse_arguments(int argc, char **argv) {
+std::vector <uint32_t> parse_arguments(int first, int argc, char **argv) {
 	std::vector <uint32_t> numbers;
 
-	for (int i = 1; i < argc; i++) {
+	for (int i = first; i < argc; i++) {
 		numbers.push_back(str_to_uint(argv[i]));
 	}
 
@@ -35,87 +258,478 @@ std::vector <uint32_t> parse_arguments(int argc, char **argv) {
 }
 
 /**
- * @brief Measures the time taken by the Ford-Johnson algorithm on a container.
+ * @brief Appends the numbers of the file and stdin sources given on the command line.
  *
- * This function times the execution of the Ford-Johnson sorting algorithm for a given container.
+ * Sources are read in the order text file, binary file, stdin, after the numbers of argv.
  *
- * @tparam T Container type (e.g., std::vector or std::deque).
- * @param container The container to be sorted.
- * @return The time taken in microseconds.
+ * @param options Names the sources.
+ * @param numbers Receives the numbers.
  */
-template<typename T>
-double measure_sort_time(T &container) {
-	clock_t start_time = clock();
+void read_input_sources(const Options &options, std::vector <uint32_t> &numbers) {
+	if (!options.text_input.empty()) {
+		read_text_file(options.text_input, numbers);
+	}
+	if (!options.binary_input.empty()) {
+		read_binary_file(options.binary_input, numbers);
+	}
+	if (options.stdin_input) {
+		read_text_stream(STDIN_FILENO, numbers);
+	}
+}
 
-	ford_johnson(container);
+/**
+ * @brief Highest resident set size of this process image so far, in bytes.
+ *
+ * VmHWM in /proc/self/status covers the current address space only. getrusage(), the
+ * fallback where /proc is missing, also carries the high-water mark a process inherits
+ * from its parent across fork and exec.
+ */
+size_t peak_rss_bytes() {
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while (std::getline(status, line)) {
+		if (line.compare(0, 6, "VmHWM:") == 0) {
+			return std::strtoul(line.c_str() + 6, NULL, 10) * static_cast<size_t>(1024);
+		}
+	}
 
-	clock_t end_time = clock();
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+	return usage.ru_maxrss;
+#else
+	return usage.ru_maxrss * static_cast<size_t>(1024);
+#endif
+}
 
-	return static_cast<double>(end_time - start_time) / CLOCKS_PER_SEC * 1e6;
+/**
+ * @brief Resident set size of the process right now, in bytes, read from /proc/self/statm.
+ *
+ * Falls back to peak_rss_bytes() where /proc is missing.
+ */
+size_t resident_bytes() {
+	std::ifstream statm("/proc/self/statm");
+	size_t pages = 0;
+	size_t resident = 0;
+	if (!(statm >> pages >> resident)) {
+		return peak_rss_bytes();
+	}
+	return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
 }
 
 /**
- * @brief Measures the time taken by std::sort on a container.
+ * @brief Sorts the single input source into a file without holding it in memory.
  *
- * This function times the execution of std::sort for a given container.
+ * Runs use --engine, or the automatic choice when none is given, since this mode is about
+ * throughput. The resident size of the process before the sort is taken out of
+ * --mem-limit, so the limit bounds the peak RSS of the whole run. Prints the figures of
+ * the sort and that peak, and fails if the peak went over the limit after all.
+ *
+ * @param options Input source, output file and external sort settings.
+ * @throws std::invalid_argument If there is not exactly one input source.
+ * @throws std::runtime_error If a file cannot be opened or the limit was exceeded.
+ */
+void run_external(const Options &options) {
+	int sources = options.stdin_input + !options.text_input.empty() + !options.binary_input.empty();
+	if (sources != 1) {
+		throw std::invalid_argument("--external needs exactly one of --input, --binary or --stdin");
+	}
+
+	ExternalSortConfig config = options.external;
+	config.engine = options.engine_given ? options.sort_engine : ENGINE_AUTO;
+	config.merge_insertion = options.engine;
+	size_t baseline = resident_bytes();
+	if (config.memory_limit <= baseline) {
+		throw std::invalid_argument("Memory limit is below the resident size of PmergeMe itself");
+	}
+	config.memory_limit -= baseline;
+
+	std::string path = options.stdin_input ? "" : !options.text_input.empty() ? options.text_input : options.binary_input;
+	int input = options.stdin_input ? STDIN_FILENO : open(path.c_str(), O_RDONLY);
+	if (input < 0) {
+		throw std::runtime_error("Cannot open " + path + ": " + std::strerror(errno));
+	}
+	int output = open(options.external_output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (output < 0) {
+		if (input != STDIN_FILENO) {
+			close(input);
+		}
+		throw std::runtime_error("Cannot open " + options.external_output + ": " + std::strerror(errno));
+	}
+
+	ExternalSortStats stats;
+	timespec start_time;
+	clock_gettime(CLOCK_MONOTONIC, &start_time);
+	try {
+		NumberSource source(input, !options.binary_input.empty(), std::min<size_t>(1 << 20, config.memory_limit / 16));
+		stats = external_sort(source, output, config);
+	} catch (...) {
+		close(output);
+		if (input != STDIN_FILENO) {
+			close(input);
+		}
+		throw;
+	}
+	double elapsed = elapsed_us(start_time);
+	close(output);
+	if (input != STDIN_FILENO) {
+		close(input);
+	}
+
+	std::cout << "Sorted " << stats.elements << " elements into " << options.external_output
+		<< " in " << elapsed << " us (" << (elapsed > 0 ? stats.elements * 4.0 / elapsed : 0) << " MB/s)" << std::endl;
+	std::cout << "Runs: " << stats.runs << " of up to " << stats.run_capacity << " elements ("
+		<< sort_engine_name(stats.engine) << "), " << stats.merges << " merge(s), fan-in "
+		<< stats.fan_in << std::endl;
+	size_t peak = peak_rss_bytes();
+	std::cout << "Peak RSS: " << peak / 1024 << " KiB (limit " << options.external.memory_limit / 1024
+		<< " KiB, " << baseline / 1024 << " KiB before sorting)" << std::endl;
+	if (peak > options.external.memory_limit) {
+		throw std::runtime_error("Peak RSS exceeded --mem-limit");
+	}
+}
+
+/**
+ * @brief Resolves --engine=auto for a container, with the comparator the sort will use.
+ */
+template<typename T>
+SortEngine resolve_engine(const T &container, const Options &options) {
+	if (options.sort_engine != ENGINE_AUTO) {
+		return options.sort_engine;
+	}
+	if (options.count) {
+		ComparisonCount counter;
+		return choose_engine(container.begin(), container.end(),
+			CountedCompare<std::less<uint32_t>, ComparisonCount>(std::less<uint32_t>(), counter));
+	}
+	return choose_engine(container.begin(), container.end(), std::less<uint32_t>());
+}
+
+/**
+ * @brief Measures the time taken by the selected engine on a container.
+ *
+ * This function times the execution of the selected sorting engine for a given container,
+ * using the arena-backed Ford-Johnson engine when requested. Counting comparisons is
+ * included in the time; the radix engine makes none.
  *
  * @tparam T Container type (e.g., std::vector or std::deque).
  * @param container The container to be sorted.
+ * @param options Selects the engine.
+ * @param report Receives the engine used, the arena figures, comparison count and allocation
+ * figures, when available.
  * @return The time taken in microseconds.
  */
 template<typename T>
-double measure_std_sort_time(T &container) {
-	clock_t start_time = clock();
+double measure_sort_time(T &container, const Options &options, SortReport &report) {
+	ComparisonCount counter;
+	report.engine = resolve_engine(container, options);
+	reset_allocation_stats();
+	timespec start_time;
+	clock_gettime(CLOCK_MONOTONIC, &start_time);
 
-	std::sort(container.begin(), container.end());
+	if (report.engine == ENGINE_RADIX) {
+		radix_sort(container.begin(), container.end(), std::less<uint32_t>());
+	} else if (report.engine == ENGINE_INTROSORT && options.count) {
+		introsort(container.begin(), container.end(),
+			CountedCompare<std::less<uint32_t>, ComparisonCount>(std::less<uint32_t>(), counter));
+	} else if (report.engine == ENGINE_INTROSORT) {
+		introsort(container.begin(), container.end(), std::less<uint32_t>());
+	} else if (options.arena && options.count) {
+		CountedCompare<std::less<uint32_t>, ComparisonCount> comp(std::less<uint32_t>(), counter);
+		report.memory = merge_insertion_sort(container.begin(), container.end(), comp, options.engine);
+	} else if (options.arena) {
+		report.memory = merge_insertion_sort(container.begin(), container.end(), std::less<uint32_t>(), options.engine);
+	} else {
+		ford_johnson(container, std::less<uint32_t>());
+	}
 
-	clock_t end_time = clock();
+	double elapsed = elapsed_us(start_time);
+	report.comparisons = counter.count();
+	report.allocation = allocation_stats();
 
-	return static_cast<double>(end_time - start_time) / CLOCKS_PER_SEC * 1e6;
+	return elapsed;
 }
 
 /**
  * @brief Displays the contents of a container.
  *
- * This function prints the contents of a container (e.g., std::vector or std::deque) to the console.
+ * This function prints the contents of a container (e.g., std::vector or std::deque) to the console,
+ * after label. The numbers go through an OutputWriter in large blocks rather than one
+ * std::cout insertion each.
  *
  * @tparam T Container type.
+ * @param label Text printed before the numbers, such as "Before: ".
  * @param container The container whose contents to display.
  */
 template<typename T>
-void display_container(const T &container) {
-	typename T::const_iterator it;
-	for (it = container.begin(); it != container.end(); ++it) {
-		std::cout << *it << " ";
+void display_container(const std::string &label, const T &container) {
+	std::cout.flush();
+
+	OutputWriter out(STDOUT_FILENO);
+	out.write(label);
+	write_numbers(out, container.begin(), container.end());
+	out.write("\n");
+	out.flush();
+}
+
+/**
+ * @brief Prints the input on the "Before:" line, unless --quiet was given.
+ */
+template<typename T>
+void display_input(const T &container, const Options &options) {
+	if (!options.quiet) {
+		display_container("Before: ", container);
 	}
-	std::cout << std::endl;
 }
 
 /**
- * @brief Compares two containers for equality.
+ * @brief Prints the sorted numbers on the "After:" line, or writes them to the
+ * --binary-output file instead.
+ */
+template<typename T>
+void display_result(const T &container, const Options &options) {
+	if (options.binary_output.empty()) {
+		display_container("After: ", container);
+		return;
+	}
+	OutputFile file(options.binary_output);
+	OutputWriter out(file.fd());
+	write_binary(out, container.begin(), container.end());
+	out.flush();
+}
+
+/**
+ * @brief Displays the memory figures of an arena-backed sort.
  *
- * This function compares two containers element-wise to determine if they are equal.
+ * @param name Name of the container that was sorted.
+ * @param stats Figures returned by the sort.
+ */
+void display_arena_stats(const char *name, const MergeInsertionStats &stats) {
+	std::cout << "Arena for " << name << ": " << stats.allocations << " allocation(s), "
+		<< stats.reserved_bytes << " bytes reserved, " << stats.peak_bytes << " bytes peak" << std::endl;
+}
+
+/**
+ * @brief Displays the allocation figures of a sort.
  *
- * @tparam T Container type.
- * @param c1 First container.
- * @param c2 Second container.
- * @return True if containers are equal, false otherwise.
+ * The peak is measured above the memory that was live when the sort started, such as the
+ * containers holding the input.
+ *
+ * @param name Name of the container that was sorted.
+ * @param stats Figures gathered during the sort.
  */
-template<typename T>
-bool compare_containers(const T &c1, const T &c2) {
-	if (c1.size() != c2.size()) {
-		return false;
-	}
-	typename T::const_iterator it1 = c1.begin();
-	typename T::const_iterator it2 = c2.begin();
-	while (it1 != c1.end()) {
-		if (*it1 != *it2) {
-			return false;
+void display_allocation_stats(const char *name, const AllocationStats &stats) {
+	std::cout << "Memory for " << name << ": " << stats.allocations << " allocation(s), "
+		<< stats.allocated_bytes << " bytes allocated, " << stats.peak_bytes - stats.baseline_bytes
+		<< " bytes peak, recursion depth " << stats.max_depth << std::endl;
+}
+
+/**
+ * @brief Displays the comparison count of a sort next to the theoretical bounds.
+ *
+ * @param name Name of the container that was sorted.
+ * @param size Number of elements sorted.
+ * @param comparisons Comparisons performed.
+ */
+void display_comparisons(const char *name, size_t size, unsigned long comparisons) {
+	std::cout << "Comparisons with " << name << ": " << comparisons
+		<< " (Ford-Johnson bound: " << ford_johnson_bound(size)
+		<< ", lower bound: " << comparison_lower_bound(size) << ")" << std::endl;
+}
+
+/**
+ * @brief Prints where the tree chain starts to beat the array chain.
+ *
+ * Sorts prefixes of doubling size of the input with the classic std::vector engine and
+ * with the arena engine using an array chain and a tree chain, then reports the first
+ * size at which the tree chain was faster than the array chain.
+ *
+ * @param numbers The parsed input.
+ */
+void run_crossover(const std::vector<uint32_t> &numbers) {
+	Options classic;
+	Options array;
+	Options tree;
+	SortReport report;
+	size_t crossover = 0;
+
+	array.arena = true;
+	tree.arena = true;
+	tree.engine.chain = TREE_CHAIN;
+
+	for (size_t size = std::min<size_t>(1024, numbers.size()); ; size = std::min(size * 2, numbers.size())) {
+		std::vector<uint32_t> classic_input(numbers.begin(), numbers.begin() + size);
+		std::vector<uint32_t> array_input(classic_input);
+		std::vector<uint32_t> tree_input(classic_input);
+
+		double classic_time = measure_sort_time(classic_input, classic, report);
+		double array_time = measure_sort_time(array_input, array, report);
+		double tree_time = measure_sort_time(tree_input, tree, report);
+
+		std::cout << "n = " << size << ": classic " << classic_time << " us, array chain " << array_time
+			<< " us, tree chain " << tree_time << " us" << std::endl;
+		if (!crossover && tree_time < array_time) {
+			crossover = size;
 		}
-		++it1;
-		++it2;
+		if (size == numbers.size()) {
+			break;
+		}
+	}
+
+	if (crossover) {
+		std::cout << "Tree chain is faster from n = " << crossover << std::endl;
+	} else {
+		std::cout << "Tree chain is not faster up to n = " << numbers.size() << std::endl;
+	}
+}
+
+/**
+ * @brief Sorts the input as records and compares comparison counts with std::sort.
+ *
+ * The merge-insertion engine sorts handles with Jacobsthal-ordered insertion and moves
+ * each record once at the end; std::sort moves records throughout. Both use a counting
+ * RecordLess, and the two results must hold the same records in the same order.
+ *
+ * @param numbers The parsed input.
+ * @param options Supplies the chain strategy.
+ */
+void run_compare_count(const std::vector<uint32_t> &numbers, const Options &options) {
+	std::vector<Record> merged;
+	for (size_t i = 0; i < numbers.size(); i++) {
+		merged.push_back(make_record(numbers[i]));
+	}
+	std::vector<Record> introsorted(merged);
+
+	ComparisonCount merge_count;
+	ComparisonCount std_count;
+	timespec start_time;
+
+	clock_gettime(CLOCK_MONOTONIC, &start_time);
+	merge_insertion_sort(merged.begin(), merged.end(), CountedCompare<RecordLess, ComparisonCount>(RecordLess(), merge_count),
+		MergeInsertionOptions(JACOBSTHAL_ORDER, options.engine.chain));
+	double merge_time = elapsed_us(start_time);
+
+	clock_gettime(CLOCK_MONOTONIC, &start_time);
+	std::sort(introsorted.begin(), introsorted.end(), CountedCompare<RecordLess, ComparisonCount>(RecordLess(), std_count));
+	double std_time = elapsed_us(start_time);
+
+	RecordLess less;
+	bool same = true;
+	for (size_t i = 0; i < merged.size() && same; i++) {
+		same = !less(merged[i], introsorted[i]) && !less(introsorted[i], merged[i]);
+	}
+
+	std::cout << "Sorting " << merged.size() << " records of " << sizeof(Record) << " bytes (key, then number)" << std::endl;
+	std::cout << "merge-insertion: " << merge_count.count() << " comparisons, " << merge_time << " us" << std::endl;
+	std::cout << "std::sort: " << std_count.count() << " comparisons, " << std_time << " us" << std::endl;
+	if (std_count.count() > 0) {
+		std::cout << "Comparisons saved: "
+			<< 100.0 * (1.0 - static_cast<double>(merge_count.count()) / std_count.count()) << "%"
+			<< " (Ford-Johnson bound: " << ford_johnson_bound(merged.size())
+			<< ", lower bound: " << comparison_lower_bound(merged.size()) << ")" << std::endl;
+	}
+	std::cout << "Same order: " << (same ? "yes" : "no") << std::endl;
+}
+
+/**
+ * @brief Measures the time taken to select the smallest options.top_k numbers of a container.
+ *
+ * @param container The input; left unchanged.
+ * @param prefix Receives the numbers, in order.
+ * @param options Supplies k, the merge-insertion tuning and whether to count comparisons.
+ * @param report Receives the comparison count, when counting.
+ * @return The time taken in microseconds.
+ */
+template<typename T>
+double measure_top_k_time(const T &container, T &prefix, const Options &options, SortReport &report) {
+	ComparisonCount counter;
+	timespec start_time;
+	clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+	if (options.count) {
+		top_k(container.begin(), container.end(), options.top_k,
+			CountedCompare<std::less<uint32_t>, ComparisonCount>(std::less<uint32_t>(), counter), prefix, options.engine);
+	} else {
+		top_k(container.begin(), container.end(), options.top_k, std::less<uint32_t>(), prefix, options.engine);
+	}
+
+	double elapsed = elapsed_us(start_time);
+	report.comparisons = counter.count();
+
+	return elapsed;
+}
+
+/**
+ * @brief Prints the input and its smallest options.top_k numbers, selected from both containers.
+ *
+ * @param numbers The parsed input.
+ * @param options Supplies k and the selection settings.
+ */
+void run_top_k(const std::vector<uint32_t> &numbers, const Options &options) {
+	std::deque<uint32_t> numbers_deque(numbers.begin(), numbers.end());
+	std::vector<uint32_t> vector_prefix;
+	std::deque<uint32_t> deque_prefix;
+	SortReport vector_report;
+	SortReport deque_report;
+
+	display_input(numbers, options);
+
+	double vector_time = measure_top_k_time(numbers, vector_prefix, options, vector_report);
+	double deque_time = measure_top_k_time(numbers_deque, deque_prefix, options, deque_report);
+
+	display_result(vector_prefix, options);
+
+	std::cout << "Time to select the " << vector_prefix.size() << " smallest of " << numbers.size()
+		<< " elements with std::vector: " << vector_time << " us" << std::endl;
+	std::cout << "Time to select the " << deque_prefix.size() << " smallest of " << numbers_deque.size()
+		<< " elements with std::deque: " << deque_time << " us" << std::endl;
+	if (options.count) {
+		std::cout << "Comparisons with std::vector: " << vector_report.comparisons
+			<< ", std::deque: " << deque_report.comparisons << std::endl;
+	}
+}
+
+/**
+ * @brief Sorts the input in a vector and in a deque and prints the timing report.
+ *
+ * @tparam Vector std::vector of uint32_t, with any allocator.
+ * @tparam Deque std::deque of uint32_t, with any allocator.
+ * @param numbers_vector The parsed input, sorted in place.
+ * @param options Selects the engine and what is printed.
+ */
+template<typename Vector, typename Deque>
+void run_sort(Vector &numbers_vector, const Options &options) {
+	Deque numbers_deque(numbers_vector.begin(), numbers_vector.end());
+
+	display_input(numbers_vector, options);
+
+	SortReport vector_report;
+	SortReport deque_report;
+	double vector_time = measure_sort_time(numbers_vector, options, vector_report);
+	double deque_time = measure_sort_time(numbers_deque, options, deque_report);
+
+	display_result(numbers_vector, options);
+
+	std::cout << "Time to process a range of " << numbers_vector.size() << " elements with std::vector: " << vector_time << " us" << std::endl;
+	std::cout << "Time to process a range of " << numbers_deque.size() << " elements with std::deque: " << deque_time << " us" << std::endl;
+
+	if (options.sort_engine != ENGINE_MERGE_INSERTION) {
+		std::cout << "Engine for std::vector: " << sort_engine_name(vector_report.engine)
+			<< ", std::deque: " << sort_engine_name(deque_report.engine)
+			<< " (" << sort_engine_name(options.sort_engine) << ")" << std::endl;
+	}
+	if (options.arena && vector_report.engine == ENGINE_MERGE_INSERTION) {
+		display_arena_stats("std::vector", vector_report.memory);
+		display_arena_stats("std::deque", deque_report.memory);
+	}
+	if (options.count) {
+		display_comparisons("std::vector", numbers_vector.size(), vector_report.comparisons);
+		display_comparisons("std::deque", numbers_deque.size(), deque_report.comparisons);
+	}
+	if (options.memory) {
+		display_allocation_stats("std::vector", vector_report.allocation);
+		display_allocation_stats("std::deque", deque_report.allocation);
 	}
-	return true;
 }
 
 /**
@@ -123,73 +737,81 @@ bool compare_containers(const T &c1, const T &c2) {
  *
  * The main function parses command-line arguments, runs the Ford-Johnson sorting algorithm
  * on both std::vector and std::deque containers, and prints the sorting time.
+ * --arena selects the arena-backed engine and prints its memory figures.
+ * --jacobsthal also switches it to Jacobsthal-ordered bounded insertion and prints comparison counts.
+ * --tree keeps the main chain in an order-statistic tree instead of an array.
+ * --crossover benchmarks the array and tree chains on growing prefixes of the input.
+ * --bench [--runs=N] [--warmup=N] times every engine and container on several distributions
+ * of the input's size and checks each result against std::sort.
+ * --compare-count sorts the input as records and compares comparison counts with std::sort.
+ * --input=FILE, --binary=FILE and --stdin add numbers from a text file, a little-endian
+ * uint32 file and standard input to those given as arguments.
+ * --memory sorts containers with a CountingAllocator and prints the allocations, bytes, peak
+ * heap use and recursion depth of each sort.
+ * --quiet leaves out the "Before:" line; --binary-output=FILE writes the sorted numbers to FILE
+ * as little-endian uint32 instead of printing the "After:" line.
+ * --top-k=K prints only the K smallest numbers, selected without sorting the whole input.
+ * --external=OUT [--mem-limit=SIZE] [--temp-dir=DIR] sorts the single input source into OUT
+ * through temporary files, within a memory budget.
+ * --threads=N runs the arena engine on N threads (0: one per processor) with batched groups.
+ * --engine=auto|merge-insertion|radix|introsort picks the algorithm; merge-insertion, the
+ * Ford-Johnson sort the program exists for, stays the default.
+ * --simd=auto|scalar|sse4.1|avx2 caps the instruction set of the uint32_t kernels.
  *
  * @param argc Argument count.
  * @param argv Argument values.
  * @return Exit status.
  */
 int main(int argc, char **argv) {
-	if (argc < 2) {
-		std::cerr << "Usage: " << argv[0] << " <numbers>..." << std::endl;
-		return EXIT_FAILURE;
-	}
+	Options options;
 
 	try {
-		std::vector <uint32_t> numbers_vector = parse_arguments(argc, argv);
-		std::deque <uint32_t> numbers_deque(numbers_vector.begin(), numbers_vector.end());
-		std::vector <uint32_t> numbers_vector_copy(numbers_vector.begin(), numbers_vector.end());
-		std::deque <uint32_t> numbers_deque_copy(numbers_deque.begin(), numbers_deque.end());
-
-		std::cout << "Before: ";
-		display_container(numbers_vector);
-
-		double vector_time = measure_sort_time(numbers_vector);
-		double deque_time = measure_sort_time(numbers_deque);
-
-		std::cout << "After: ";
-		display_container(numbers_vector);
-
-		std::cout << "Time to process a range of " << numbers_vector.size() << " elements with std::vector: " << vector_time << " us" << std::endl;
-		std::cout << "Time to process a range of " << numbers_deque.size() << " elements with std::deque: " << deque_time << " us" << std::endl;
-
-//		// Compare with std::sort
-//		double std_sort_vector_time = measure_std_sort_time(numbers_vector_copy);
-//		double std_sort_deque_time = measure_std_sort_time(numbers_deque_copy);
-//		bool vector_correct = compare_containers(numbers_vector, numbers_vector_copy);
-//		bool deque_correct = compare_containers(numbers_deque, numbers_deque_copy);
-//
-//		std::cout << std::endl << " --- After sorting --- " << std::endl << std::endl;
-//
-//		std::cout << "Vector After: ";
-//		display_container(numbers_vector);
-//
-//		std::cout << std::endl;
-//
-//		std::cout << "Deque After: ";
-//		display_container(numbers_deque);
-//
-//		std::cout << std::endl;
-//
-//		std::cout << "Vector After (std::sort): ";
-//		display_container(numbers_vector_copy);
-//
-//		std::cout << std::endl;
-//
-//		std::cout << "Deque After (std::sort): ";
-//		display_container(numbers_deque_copy);
-//
-//		std::cout << std::endl << " --- Value Comparison --- " << std::endl << std::endl;
-//
-//		std::cout << "Vector Correct: " << (vector_correct ? "Yes" : "No") << std::endl;
-//		std::cout << "Deque Correct: " << (deque_correct ? "Yes" : "No") << std::endl;
-//
-//		std::cout << std::endl << " --- Time Comparison --- " << std::endl << std::endl;
-//
-//		std::cout << "Time to process with std::vector: " << vector_time << " us" << std::endl;
-//		std::cout << "Time to process with std::deque: " << deque_time << " us" << std::endl;
-//		std::cout << "Time to process with std::sort on std::vector: " << std_sort_vector_time << " us" << std::endl;
-//		std::cout << "Time to process with std::sort on std::deque: " << std_sort_deque_time << " us" << std::endl;
+		int first = parse_options(argc, argv, options);
+		if (first >= argc && !options.hasInputSource()) {
+			std::cerr << "Usage: " << argv[0] << " [--arena] [--jacobsthal] [--tree] [--crossover] [--compare-count]"
+				<< " [--bench] [--runs=N] [--warmup=N] [--threads=N] [--engine=NAME] [--simd=LEVEL]"
+				<< " [--memory] [--quiet] [--binary-output=FILE] [--top-k=K]"
+				<< " [--input=FILE] [--binary=FILE] [--stdin] [--external=OUT] [--mem-limit=SIZE] [--temp-dir=DIR]"
+				<< " <numbers>..." << std::endl;
+			return EXIT_FAILURE;
+		}
+		if (!options.external_output.empty()) {
+			if (first < argc) {
+				throw std::invalid_argument("--external reads its input from --input, --binary or --stdin");
+			}
+			run_external(options);
+			return EXIT_SUCCESS;
+		}
+
+		std::vector <uint32_t> numbers_vector = parse_arguments(first, argc, argv);
+		read_input_sources(options, numbers_vector);
+		if (numbers_vector.empty()) {
+			throw std::invalid_argument("No input numbers");
+		}
+		if (options.crossover) {
+			run_crossover(numbers_vector);
+			return EXIT_SUCCESS;
+		}
+		if (options.compare_count) {
+			run_compare_count(numbers_vector, options);
+			return EXIT_SUCCESS;
+		}
+		if (options.benchmark) {
+			options.bench.arena = options.engine;
+			return run_benchmark(numbers_vector, options.bench) ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+		if (options.top_k > 0) {
+			run_top_k(numbers_vector, options);
+			return EXIT_SUCCESS;
+		}
 
+		if (options.memory) {
+			CountedVector counted(numbers_vector.begin(), numbers_vector.end());
+			std::vector <uint32_t>().swap(numbers_vector);
+			run_sort<CountedVector, CountedDeque>(counted, options);
+		} else {
+			run_sort<std::vector <uint32_t>, std::deque <uint32_t> >(numbers_vector, options);
+		}
 	} catch (const std::exception &e) {
 		std::cerr << "Error: " << e.what() << std::endl;
 		return EXIT_FAILURE;
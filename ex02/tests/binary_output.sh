@@ -0,0 +1,63 @@
+#!/bin/sh
+# Checks --binary-output (little-endian uint32) and the buffered "After:" line against
+# sort -n, across the writer's buffer size, and reads the binary file back with --binary.
+# Usage: tests/binary_output.sh [path/to/PmergeMe]
+
+BIN=${1:-./PmergeMe}
+DIR=$(mktemp -d) || exit 1
+trap 'rm -rf "$DIR"' EXIT
+status=0
+
+# Prints the little-endian 32-bit words of a file, one per line, whatever the host order.
+decode() {
+	od -An -v -tu1 "$1" | awk '
+	BEGIN { byte = 0; word = 0; scale[0] = 1; scale[1] = 256; scale[2] = 65536; scale[3] = 16777216 }
+	{
+		for (i = 1; i <= NF; i++) {
+			word += $i * scale[byte]
+			if (++byte == 4) {
+				printf "%.0f\n", word
+				word = 0
+				byte = 0
+			}
+		}
+	}'
+}
+
+for n in 1 2 17 1000 100000; do
+	awk -v n=$n 'BEGIN { srand(n); print "4294967295"; print 0; for (i = 2; i < n; i++) print int(rand() * 1000000000) }' \
+		| head -n $n > "$DIR/in.txt"
+	sort -n "$DIR/in.txt" > "$DIR/expected"
+	bad=0
+
+	if ! "$BIN" --quiet --input="$DIR/in.txt" > "$DIR/out" 2>&1; then
+		echo "FAIL: n=$n text: $(head -n 1 "$DIR/out")"
+		bad=1
+	else
+		grep '^After:' "$DIR/out" | sed 's/^After://' | tr -s ' ' '\n' | sed '/^$/d' > "$DIR/actual"
+		cmp -s "$DIR/actual" "$DIR/expected" || { echo "FAIL: n=$n text: wrong order"; bad=1; }
+		grep -q '^Before:' "$DIR/out" && { echo "FAIL: n=$n: --quiet printed Before:"; bad=1; }
+	fi
+
+	if ! "$BIN" --quiet --binary-output="$DIR/out.bin" --input="$DIR/in.txt" > "$DIR/out" 2>&1; then
+		echo "FAIL: n=$n binary: $(head -n 1 "$DIR/out")"
+		bad=1
+	else
+		grep -q '^After:' "$DIR/out" && { echo "FAIL: n=$n: After: printed with --binary-output"; bad=1; }
+		[ "$(wc -c < "$DIR/out.bin")" -eq $((4 * n)) ] || { echo "FAIL: n=$n binary: wrong size"; bad=1; }
+		decode "$DIR/out.bin" > "$DIR/actual"
+		cmp -s "$DIR/actual" "$DIR/expected" || { echo "FAIL: n=$n binary: wrong words"; bad=1; }
+
+		"$BIN" --quiet --binary="$DIR/out.bin" > "$DIR/out" 2>&1
+		grep '^After:' "$DIR/out" | sed 's/^After://' | tr -s ' ' '\n' | sed '/^$/d' > "$DIR/actual"
+		cmp -s "$DIR/actual" "$DIR/expected" || { echo "FAIL: n=$n binary: does not read back"; bad=1; }
+	fi
+
+	if [ $bad -eq 0 ]; then
+		echo "ok: n=$n"
+	else
+		status=1
+	fi
+done
+
+exit $status
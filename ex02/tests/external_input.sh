@@ -0,0 +1,32 @@
+#!/bin/sh
+# Checks that --external accepts text input whose last number has no trailing newline.
+# Usage: tests/external_input.sh [path/to/PmergeMe]
+
+BIN=${1:-./PmergeMe}
+DIR=$(mktemp -d) || exit 1
+trap 'rm -rf "$DIR"' EXIT
+status=0
+
+expect() {
+	actual=$(od -An -tu4 -v "$DIR/out.bin" | tr -s ' \n' ' ' | sed 's/^ //; s/ $//')
+	if [ "$actual" = "$2" ]; then
+		echo "ok: $1"
+	else
+		echo "FAIL: $1: got '$actual', expected '$2'"
+		status=1
+	fi
+}
+
+printf '3 1 2' | "$BIN" --external="$DIR/out.bin" --stdin >/dev/null || status=1
+expect "stdin without trailing newline" "1 2 3"
+
+printf '30\n10\n20' > "$DIR/in.txt"
+"$BIN" --external="$DIR/out.bin" --input="$DIR/in.txt" >/dev/null || status=1
+expect "file without trailing newline" "10 20 30"
+
+# A last token split across the block buffer, which starts at 1 MiB.
+seq 300000 -1 1 | head -c -1 > "$DIR/in.txt"
+"$BIN" --external="$DIR/out.bin" --input="$DIR/in.txt" >/dev/null || status=1
+expect "large file without trailing newline" "$(seq 1 300000 | tr '\n' ' ' | sed 's/ $//')"
+
+exit $status
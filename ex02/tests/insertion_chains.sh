@@ -0,0 +1,68 @@
+#!/bin/sh
+# Checks the arena engine on its array, tree and batched chains in both insertion
+# orders: every run must sort, and Jacobsthal order must stay within the Ford-Johnson
+# bound and spend the same comparisons on the array and tree chains.
+# Usage: tests/insertion_chains.sh [path/to/PmergeMe]
+
+BIN=${1:-./PmergeMe}
+DIR=$(mktemp -d) || exit 1
+trap 'rm -rf "$DIR"' EXIT
+status=0
+
+# run NAME OPTIONS...: sorts in.txt, compares with sort -n, keeps the report in report.txt
+run() {
+	name=$1
+	shift
+	if ! "$BIN" --quiet "$@" --input="$DIR/in.txt" > "$DIR/report.txt" 2>&1; then
+		echo "FAIL: $name: $(head -n 1 "$DIR/report.txt")"
+		bad=1
+		return 1
+	fi
+	grep '^After:' "$DIR/report.txt" | sed 's/^After://' | tr -s ' ' '\n' | sed '/^$/d' > "$DIR/actual"
+	if ! cmp -s "$DIR/actual" "$DIR/expected"; then
+		echo "FAIL: $name: wrong order"
+		bad=1
+		return 1
+	fi
+	return 0
+}
+
+# Prints the vector comparison count of report.txt, or fails when it exceeds the bound.
+within_bound() {
+	awk '/^Comparisons with std::vector:/ {
+		count = $4; bound = $7; sub(/,/, "", bound)
+		print count
+		exit !(count + 0 <= bound + 0)
+	}' "$DIR/report.txt"
+}
+
+for n in 1 2 3 5 21 22 43 1000 20001 50000; do
+	awk -v n=$n 'BEGIN { srand(n); for (i = 0; i < n; i++) print int(rand() * 1000000) }' > "$DIR/in.txt"
+	sort -n "$DIR/in.txt" > "$DIR/expected"
+	bad=0
+
+	run "n=$n array midpoint" --arena
+	run "n=$n tree midpoint" --arena --tree
+	run "n=$n batched" --arena --threads=4
+	run "n=$n batched jacobsthal" --arena --threads=4 --jacobsthal
+
+	array=
+	tree=
+	if run "n=$n array jacobsthal" --jacobsthal; then
+		array=$(within_bound) || { echo "FAIL: n=$n array jacobsthal: above the bound"; bad=1; }
+	fi
+	if run "n=$n tree jacobsthal" --jacobsthal --tree; then
+		tree=$(within_bound) || { echo "FAIL: n=$n tree jacobsthal: above the bound"; bad=1; }
+	fi
+	if [ "$array" != "$tree" ]; then
+		echo "FAIL: n=$n: array and tree chains disagree ($array vs $tree comparisons)"
+		bad=1
+	fi
+	if [ $bad -eq 0 ]; then
+		echo "ok: n=$n ($array comparisons)"
+	else
+		status=1
+	fi
+done
+
+exit $status
@@ -0,0 +1,28 @@
+#!/bin/sh
+# Checks the threaded arena engine with far more threads than parallel_sort has blocks
+# to fill, which used to read past the end of its key buffer.
+# Usage: tests/many_threads.sh [path/to/PmergeMe]
+
+BIN=${1:-./PmergeMe}
+DIR=$(mktemp -d) || exit 1
+trap 'rm -rf "$DIR"' EXIT
+status=0
+
+for n in 20000 33000 50001 70000 100003; do
+	awk -v n=$n 'BEGIN { srand(n); for (i = 0; i < n; i++) print int(rand() * 1000000) }' > "$DIR/in.txt"
+	sort -n "$DIR/in.txt" > "$DIR/expected"
+	if ! "$BIN" --quiet --threads=200 --input="$DIR/in.txt" > "$DIR/out" 2>&1; then
+		echo "FAIL: --threads=200 on $n numbers exited with an error"
+		status=1
+		continue
+	fi
+	grep '^After:' "$DIR/out" | sed 's/^After://' | tr -s ' ' '\n' | sed '/^$/d' > "$DIR/actual"
+	if cmp -s "$DIR/actual" "$DIR/expected"; then
+		echo "ok: --threads=200 on $n numbers"
+	else
+		echo "FAIL: --threads=200 on $n numbers: wrong order"
+		status=1
+	fi
+done
+
+exit $status
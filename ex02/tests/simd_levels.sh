@@ -0,0 +1,53 @@
+#!/bin/sh
+# Checks that every SIMD level the CPU supports sorts exactly like the scalar kernels,
+# on the sizes around the kernel widths, and that --bench finds every level matching.
+# Usage: tests/simd_levels.sh [path/to/PmergeMe]
+
+BIN=${1:-./PmergeMe}
+DIR=$(mktemp -d) || exit 1
+trap 'rm -rf "$DIR"' EXIT
+status=0
+
+levels=
+for level in scalar sse4.1 avx2; do
+	if "$BIN" --quiet --simd=$level 1 > /dev/null 2>&1; then
+		levels="$levels $level"
+	else
+		echo "skip: $level is not supported here"
+	fi
+done
+
+for n in 1 2 3 4 5 7 8 9 15 16 17 31 32 33 63 64 65 1000 4099; do
+	# Values up to INT_MAX with plenty of duplicates.
+	awk -v n=$n 'BEGIN { srand(n); for (i = 0; i < n; i++) print (i % 5 ? int(rand() * 2147483648) : int(rand() * 4)) }' \
+		> "$DIR/in.txt"
+	sort -n "$DIR/in.txt" > "$DIR/expected"
+	bad=0
+	for level in $levels; do
+		if ! "$BIN" --quiet --simd=$level --input="$DIR/in.txt" > "$DIR/out" 2>&1; then
+			echo "FAIL: n=$n $level: $(head -n 1 "$DIR/out")"
+			bad=1
+			continue
+		fi
+		grep '^After:' "$DIR/out" | sed 's/^After://' | tr -s ' ' '\n' | sed '/^$/d' > "$DIR/actual"
+		if ! cmp -s "$DIR/actual" "$DIR/expected"; then
+			echo "FAIL: n=$n $level: wrong order"
+			bad=1
+		fi
+	done
+	if [ $bad -eq 0 ]; then
+		echo "ok: n=$n on$levels"
+	else
+		status=1
+	fi
+done
+
+seq 1 300 | awk '{ print ($1 * 2654435761) % 1000003 }' > "$DIR/in.txt"
+if "$BIN" --bench --runs=1 --warmup=0 --input="$DIR/in.txt" > "$DIR/out" 2>&1 && ! grep -q 'scalar: NO' "$DIR/out"; then
+	echo "ok: $(grep '^SIMD kernels:' "$DIR/out")"
+else
+	echo "FAIL: benchmark kernel check: $(grep -m 1 'SIMD kernels:\|Error' "$DIR/out")"
+	status=1
+fi
+
+exit $status
@@ -0,0 +1,30 @@
+#!/bin/sh
+# Checks that the vector, deque and tiered Ford-Johnson chains sort correctly and
+# spend the same number of comparisons on every benchmark distribution.
+# Usage: tests/tiered_chain.sh [path/to/PmergeMe]
+
+BIN=${1:-./PmergeMe}
+DIR=$(mktemp -d) || exit 1
+trap 'rm -rf "$DIR"' EXIT
+status=0
+
+for n in 2000 5003; do
+	awk -v n=$n 'BEGIN { srand(n); for (i = 0; i < n; i++) print int(rand() * 1000000000) }' > "$DIR/in.txt"
+	if ! "$BIN" --bench --runs=1 --warmup=0 --input="$DIR/in.txt" > "$DIR/out" 2>&1; then
+		echo "FAIL: n=$n: benchmark reported an error"
+		status=1
+		continue
+	fi
+	# Rows of the classic engine: merge-insertion, merge-insertion/vector, /deque, /tiered.
+	awk '$2 ~ /^merge-insertion(\/vector|\/deque|\/tiered)?$/ { print $1, $6 }' "$DIR/out" | sort -u > "$DIR/counts"
+	rows=$(wc -l < "$DIR/counts")
+	inputs=$(cut -d' ' -f1 "$DIR/counts" | sort -u | wc -l)
+	if [ "$rows" -eq 0 ] || [ "$rows" -ne "$inputs" ]; then
+		echo "FAIL: n=$n: chains disagree on comparison counts"
+		status=1
+	else
+		echo "ok: n=$n, $inputs distributions"
+	fi
+done
+
+exit $status
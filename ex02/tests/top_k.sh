@@ -0,0 +1,38 @@
+#!/bin/sh
+# Checks --top-k against sort -n | head, on both selection paths and with k above n.
+# Usage: tests/top_k.sh [path/to/PmergeMe]
+
+BIN=${1:-./PmergeMe}
+DIR=$(mktemp -d) || exit 1
+trap 'rm -rf "$DIR"' EXIT
+status=0
+
+# check NAME K INPUT_FILE
+check() {
+	sort -n "$3" | head -n "$2" > "$DIR/expected"
+	if ! "$BIN" --quiet --top-k="$2" --input="$3" > "$DIR/out" 2>&1; then
+		echo "FAIL: $1: $(head -n 1 "$DIR/out")"
+		status=1
+		return
+	fi
+	grep '^After:' "$DIR/out" | sed 's/^After://' | tr -s ' ' '\n' | sed '/^$/d' > "$DIR/actual"
+	if cmp -s "$DIR/actual" "$DIR/expected"; then
+		echo "ok: $1"
+	else
+		echo "FAIL: $1: wrong numbers"
+		status=1
+	fi
+}
+
+printf '5\n3\n1\n2\n' > "$DIR/small.txt"
+check "k far above n" 4000000000 "$DIR/small.txt"
+check "k just above n" 5 "$DIR/small.txt"
+check "k equal to n" 4 "$DIR/small.txt"
+
+awk 'BEGIN { srand(7); for (i = 0; i < 20000; i++) print int(rand() * 5000) }' > "$DIR/many.txt"
+check "k = 1" 1 "$DIR/many.txt"
+check "bounded buffer, duplicates" 100 "$DIR/many.txt"
+check "selection" 3000 "$DIR/many.txt"
+check "selection, k above n" 30000 "$DIR/many.txt"
+
+exit $status